@@ -0,0 +1,87 @@
+#! /usr/bin/env python
+
+"""
+Compare evaluating canonical PDB collections PDB by PDB against the
+batched evaluation over the flattened collection. The heuristic values
+are the same, so only the time per expansion may differ.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'batched-cpdbs-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+# Last revision that evaluates the PDBs one by one, and the new one.
+REVS = ['e633c6a', 'HEAD']
+
+CONFIGS = [
+    ('cpdbs-sys2', 'astar(cpdbs(patterns=systematic(2)))'),
+    ('cpdbs-sys3', 'astar(cpdbs(patterns=systematic(3),use_cost_bound=false))'),
+    ('ipdb', 'astar(ipdb(max_time=100))'),
+]
+
+for rev in REVS:
+    for nick, search in CONFIGS:
+        exp.add_algorithm('%s-%s' % (rev, nick), REPO, rev, ['--search', search])
+
+
+def add_time_per_expansion(run):
+    if run.get('search_time') is not None and run.get('expansions'):
+        run['search_time_per_expansion'] = (
+            run['search_time'] / float(run['expansions']))
+    return run
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'search_time',
+              'search_time_per_expansion', 'memory', 'plan_util_old']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (REVS[0], nick), '%s-%s' % (REVS[1], nick))
+         for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES, filter=add_time_per_expansion),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
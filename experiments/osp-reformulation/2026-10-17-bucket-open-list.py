@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+"""
+Compare the map-based tie-breaking open list of A* with the bucket-based
+one (astar(..., bucket_open_list=true)). Both expand the same states, so
+only the search time and memory should differ. Blind search has the
+cheapest evaluations, so open list operations are the largest fraction
+of its search time.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['blocks', 'depot', 'driverlog', 'grid', 'gripper',
+           'logistics00', 'miconic', 'rovers', 'satellite', 'visitall-opt14-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'bucket-open-list-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+REV = 'HEAD'
+OPEN_LISTS = ['map', 'buckets']
+
+CONFIGS = [
+    ('blind', 'astar(blind(),bucket_open_list=%s)'),
+    ('hmax', 'astar(hmax(),bucket_open_list=%s)'),
+]
+
+for nick, search in CONFIGS:
+    for open_list in OPEN_LISTS:
+        exp.add_algorithm(
+            '%s-%s' % (nick, open_list), REPO, REV,
+            ['--search', search % str(open_list == 'buckets').lower()])
+
+
+def add_time_per_expansion(run):
+    if run.get('search_time') is not None and run.get('expansions'):
+        run['search_time_per_expansion'] = (
+            run['search_time'] / float(run['expansions']))
+    return run
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'generated', 'search_time',
+              'search_time_per_expansion', 'memory']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (nick, OPEN_LISTS[0]), '%s-%s' % (nick, OPEN_LISTS[1]))
+         for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES, filter=add_time_per_expansion),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
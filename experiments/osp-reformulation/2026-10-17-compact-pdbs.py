@@ -0,0 +1,86 @@
+#! /usr/bin/env python
+
+"""
+Compare PDBs with 4-byte distance tables (the last revision before the
+compact tables) against compact tables with exact and quantized
+distances. Exact compact tables must give identical expansions with less
+memory; quantization trades heuristic accuracy for smaller cells.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'compact-pdbs-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+# Last revision with 4-byte distance tables, and the new one.
+REVS = ['005f796', 'HEAD']
+
+CONFIGS = [
+    ('pdb', 'astar(pdb(pattern=greedy(8000000)))'),
+    ('ipdb', 'astar(ipdb())'),
+]
+
+for rev in REVS:
+    for nick, search in CONFIGS:
+        exp.add_algorithm('%s-%s' % (rev, nick), REPO, rev, ['--search', search])
+
+for quantum in [2, 4]:
+    exp.add_algorithm(
+        'HEAD-pdb-q%d' % quantum, REPO, 'HEAD',
+        ['--search', 'astar(pdb(pattern=greedy(8000000),distance_quantum=%d))' % quantum])
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'search_time', 'total_time',
+              'memory', 'pdb_cell_bytes', 'plan_util_old']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (REVS[0], nick), '%s-%s' % (REVS[1], nick))
+         for nick, _ in CONFIGS] +
+        [('HEAD-pdb', 'HEAD-pdb-q%d' % quantum) for quantum in [2, 4]],
+        attributes=ATTRIBUTES),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
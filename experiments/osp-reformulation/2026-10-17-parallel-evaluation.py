@@ -0,0 +1,88 @@
+#! /usr/bin/env python
+
+"""
+Evaluate the new successors of each expansion concurrently with
+parallel(eval, num_threads), for heuristics whose evaluation dominates
+the search time. Expansions must not change with the number of threads,
+so the interesting attribute is the search time.
+
+Runs locally with one task at a time, so that the threads get the cores.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.absolute import AbsoluteReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'driverlog', 'logistics00',
+           'miconic', 'rovers', 'satellite', 'tpp', 'zenotravel']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'parallel-evaluation-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+REV = 'HEAD'
+
+MS = ("merge_and_shrink(shrink_strategy=shrink_bisimulation(greedy=false),"
+      "merge_strategy=merge_sccs(order_of_sccs=topological,"
+      "merge_selector=score_based_filtering(scoring_functions=[goal_relevance,dfp,"
+      "total_order(atomic_before_product=false,atomic_ts_order=reverse_level,"
+      "product_ts_order=new_to_old)])),"
+      "label_reduction=exact(before_shrinking=true,before_merging=false),"
+      "max_states=20000,threshold_before_merge=1,"
+      "transform=osp_utility_to_cost(),use_cost_bound=true)")
+
+HEURISTICS = [
+    ('lmcut', 'lmcut()'),
+    ('ms', MS),
+]
+
+for nick, heuristic in HEURISTICS:
+    exp.add_algorithm(
+        '%s-sequential' % nick, REPO, REV,
+        ['--search', 'astar(%s)' % heuristic])
+    for num_threads in [1, 2, 4, 8]:
+        exp.add_algorithm(
+            '%s-parallel-%d' % (nick, num_threads), REPO, REV,
+            ['--search', 'astar(parallel(%s,num_threads=%d))' % (heuristic, num_threads)])
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'evaluations', 'search_time',
+              'total_time', 'memory']
+
+exp.add_report(
+    AbsoluteReport(attributes=ATTRIBUTES),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
@@ -0,0 +1,92 @@
+#! /usr/bin/env python
+
+"""
+Compare building pattern databases sequentially and with several
+threads. The heuristics do not depend on the number of threads, so the
+expansions must be identical; the preprocessing times show the speedup,
+the memory shows the cost of building PDBs concurrently.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'parallel-pdbs-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+REV = 'HEAD'
+
+NUM_THREADS = 4
+
+# Configurations as format strings for the number of threads. iPDB runs
+# without a time limit, since the patterns found under a limit depend on
+# the speed of the PDB construction. Dominance pruning crashes on the empty
+# patterns the genetic generator can produce, so it is turned off there.
+CONFIGS = [
+    ('ipdb', 'astar(ipdb(num_threads=%d))'),
+    ('cpdbs-sys2',
+     'astar(cpdbs(patterns=systematic(2,num_threads=%d),num_threads=%d))'),
+    ('cpdbs-genetic',
+     'astar(cpdbs(patterns=genetic(num_threads=%d),'
+     'max_time_dominance_pruning=0))'),
+]
+
+for nick, search in CONFIGS:
+    for num_threads in [1, NUM_THREADS]:
+        num_args = search.count('%d')
+        exp.add_algorithm(
+            '%s-%dt' % (nick, num_threads), REPO, REV,
+            ['--search', search % ((num_threads,) * num_args)])
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'search_time', 'total_time',
+              'memory', 'pdb_construction_time', 'bounded_pdb_construction_time',
+              'hill_climbing_time', 'pattern_generation_time', 'plan_util_old']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-1t' % nick, '%s-%dt' % (nick, NUM_THREADS)) for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
@@ -0,0 +1,90 @@
+#! /usr/bin/env python
+
+"""
+Compare pattern database heuristics that ignore the cost bound with
+PDBs that store the abstract goal distances under all bounds on the
+remaining bounded cost. The bounded tables are larger and take longer to
+build, which the construction times and memory show.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'pdb-bound-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+REV = 'HEAD'
+
+# Pairs of configurations without and with the cost bound.
+CONFIGS = [
+    ('pdb', 'astar(pdb(use_cost_bound=false))', 'astar(pdb())'),
+    ('cpdbs', 'astar(cpdbs(patterns=systematic(2),use_cost_bound=false))',
+     'astar(cpdbs(patterns=systematic(2)))'),
+    ('ipdb', 'astar(ipdb(max_time=100,use_cost_bound=false))',
+     'astar(ipdb(max_time=100))'),
+]
+
+for nick, nobound_search, bound_search in CONFIGS:
+    exp.add_algorithm('%s-nocb' % nick, REPO, REV, ['--search', nobound_search])
+    exp.add_algorithm('%s-cb' % nick, REPO, REV, ['--search', bound_search])
+
+
+def add_time_per_expansion(run):
+    if run.get('search_time') is not None and run.get('expansions'):
+        run['search_time_per_expansion'] = (
+            run['search_time'] / float(run['expansions']))
+    return run
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'generated', 'search_time',
+              'search_time_per_expansion', 'memory', 'pdb_construction_time',
+              'bounded_pdb_construction_time', 'plan_util_old']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-nocb' % nick, '%s-cb' % nick) for nick, _, _ in CONFIGS],
+        attributes=ATTRIBUTES, filter=add_time_per_expansion),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
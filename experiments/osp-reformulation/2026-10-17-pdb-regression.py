@@ -0,0 +1,84 @@
+#! /usr/bin/env python
+
+"""
+Compare the construction time of large PDBs before and after
+enumerating the goal states directly, reusing the operator buffer and
+regressing breadth-first when all operators have the same cost. The
+unit-cost configurations use the breadth-first search.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'pdb-regression-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+# Last revision that runs Dijkstra for all PDBs, and the new one.
+REVS = ['60ab071', 'HEAD']
+
+CONFIGS = [
+    ('pdb-2m', 'astar(pdb(pattern=greedy(2000000),use_cost_bound=false))'),
+    ('pdb-20m', 'astar(pdb(pattern=greedy(20000000),use_cost_bound=false))'),
+    ('pdb-20m-unit',
+     'astar(pdb(pattern=greedy(20000000),use_cost_bound=false,'
+     'transform=adapt_costs(one)))'),
+    ('pdb-2m-cb', 'astar(pdb(pattern=greedy(2000000)))'),
+]
+
+for rev in REVS:
+    for nick, search in CONFIGS:
+        exp.add_algorithm('%s-%s' % (rev, nick), REPO, rev, ['--search', search])
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'pdb_construction_time', 'memory',
+              'plan_util_old']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (REVS[0], nick), '%s-%s' % (REVS[1], nick))
+         for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
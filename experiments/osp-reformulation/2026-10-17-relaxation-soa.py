@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+"""
+Compare the time per evaluation of the relaxation heuristics (hmax, add,
+ff) before and after switching RelaxationHeuristic to the flat
+structure-of-arrays representation of the relaxed task.
+
+Runs locally, since per-evaluation times from different grid nodes are
+not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+# Domains with large relaxed tasks, where the memory layout matters most.
+domains = ['airport', 'logistics98', 'pipesworld-tankage', 'rovers',
+           'satellite', 'scanalyzer-opt11-strips', 'tpp', 'trucks-strips',
+           'visitall-opt14-strips', 'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'relaxation-soa-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+# Last revision with the pointer-based relaxed task, and the new one.
+REVS = ['2b74c9e', 'HEAD']
+
+CONFIGS = [
+    ('hmax', 'astar(hmax())'),
+    ('add', 'astar(add())'),
+    ('ff', 'astar(ff())'),
+]
+
+for rev in REVS:
+    for nick, search in CONFIGS:
+        exp.add_algorithm('%s-%s' % (rev, nick), REPO, rev, ['--search', search])
+
+
+def add_time_per_evaluation(run):
+    if run.get('search_time') is not None and run.get('evaluations'):
+        run['search_time_per_evaluation'] = (
+            run['search_time'] / float(run['evaluations']))
+    return run
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'evaluations', 'search_time',
+              'search_time_per_evaluation', 'plan_util']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (REVS[0], nick), '%s-%s' % (REVS[1], nick))
+         for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES, filter=add_time_per_evaluation),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
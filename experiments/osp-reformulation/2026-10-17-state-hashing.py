@@ -0,0 +1,89 @@
+#! /usr/bin/env python
+
+"""
+Compare hashing and comparing packed states in the state registry with
+utils::HashState and std::equal against the word-wise hash and
+comparison. Blind search spends a large part of its time registering
+states. The hash set statistics show whether the new hash function
+distributes states as well as the old one.
+
+Runs locally, since times from different grid nodes are not comparable.
+"""
+
+import os, sys
+
+from downward.experiment import FastDownwardExperiment
+from downward.reports.compare import ComparativeReport
+from lab.environments import LocalEnvironment
+
+
+def get_repo_base():
+    """Get base directory of the repository, as an absolute path."""
+    path = os.path.abspath(os.path.dirname(os.path.abspath(sys.argv[0])))
+    while os.path.dirname(path) != path:
+        if os.path.exists(os.path.join(path, ".hg")) or os.path.exists(os.path.join(path, ".git")):
+            return path
+        path = os.path.dirname(path)
+    sys.exit("repo base could not be found")
+
+
+REPO = get_repo_base()
+BENCHMARKS_DIR = '/homes/hny1/US1J6721/software/osp_benchmarks/benchmarks_general_utility'
+
+# Domains with states of very different sizes.
+domains = ['airport', 'blocks', 'depot', 'gripper', 'logistics98',
+           'pipesworld-tankage', 'satellite', 'tpp', 'visitall-opt14-strips',
+           'woodworking-opt11-strips']
+bounds = ['25', '50']
+
+SUITE = []
+for x in domains:
+    for y in bounds:
+        SUITE.append('%s-%s' % (x,y))
+
+ENV = LocalEnvironment(processes=1)
+
+exp = FastDownwardExperiment(environment=ENV)
+exp.add_parser(exp.TRANSLATOR_PARSER)
+exp.add_parser(exp.SINGLE_SEARCH_PARSER)
+exp.add_parser('osp_parser.py')
+
+report_name = 'state-hashing-26-10-17'
+
+exp.add_suite(BENCHMARKS_DIR, SUITE)
+
+# Last revision that hashes states with HashState, and the new one.
+REVS = ['6a377a5', 'HEAD']
+
+CONFIGS = [
+    ('blind', 'astar(blind())'),
+]
+
+for rev in REVS:
+    for nick, search in CONFIGS:
+        exp.add_algorithm('%s-%s' % (rev, nick), REPO, rev, ['--search', search])
+
+
+def add_time_per_expansion(run):
+    if run.get('search_time') is not None and run.get('expansions'):
+        run['search_time_per_expansion'] = (
+            run['search_time'] / float(run['expansions']))
+    return run
+
+
+exp.add_step('build', exp.build)
+exp.add_step('start', exp.start_runs)
+exp.add_fetcher(name='fetch')
+
+ATTRIBUTES = ['coverage', 'expansions', 'generated', 'search_time',
+              'search_time_per_expansion', 'memory', 'hash_set_load_factor',
+              'hash_set_resizes']
+
+exp.add_report(
+    ComparativeReport(
+        [('%s-%s' % (REVS[0], nick), '%s-%s' % (REVS[1], nick))
+         for nick, _ in CONFIGS],
+        attributes=ATTRIBUTES, filter=add_time_per_expansion),
+    outfile='%s.html' % report_name)
+
+exp.run_steps()
@@ -23,6 +23,13 @@ parser.add_pattern('util_initial_state', r'Initial State has utility: (\d+)',typ
 parser.add_pattern('util_upper_bound', r'Utility upper-bound: (\d+)',type=int, required=False)
 parser.add_pattern('plan_util_old', r'Solution found with utility value: (\d+)',type=int, required=False)
 parser.add_pattern('plan_util_new', r'Plan utility: (\d+)',type=int, required=False)
+parser.add_pattern('hash_set_load_factor', r'Int hash set load factor: \d+/\d+ = (.+)',type=float, required=False)
+parser.add_pattern('hash_set_resizes', r'Int hash set resizes: (\d+)',type=int, required=False)
+parser.add_pattern('pdb_construction_time', r'PDB (?:collection )?construction time: (.+)s',type=float, required=False)
+parser.add_pattern('bounded_pdb_construction_time', r'Bounded PDB construction time: (.+)s',type=float, required=False)
+parser.add_pattern('hill_climbing_time', r'iPDB: hill climbing time: (.+)s',type=float, required=False)
+parser.add_pattern('pattern_generation_time', r'Pattern generation \(hill climbing\) time: (.+)s',type=float, required=False)
+parser.add_pattern('pdb_cell_bytes', r'PDB distance table: (\d+) byte',type=int, required=False)
 parser.add_function(plan_util)
 parser.add_function(osp_coverage)
 
@@ -79,7 +79,7 @@ fast_downward_plugin(
         task_id
         task_proxy
 
-    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS CAUSAL_GRAPH INT_HASH_SET INT_PACKER MAPPED_SEGMENT_POOL ORDERED_SET SEGMENTED_VECTOR SUBSCRIBER SUCCESSOR_GENERATOR TASK_PROPERTIES
     CORE_PLUGIN
 )
 
@@ -116,6 +116,7 @@ fast_downward_plugin(
         utils/markup
         utils/math
         utils/memory
+        utils/parallel
         utils/rng
         utils/rng_options
         utils/system
@@ -153,6 +154,13 @@ fast_downward_plugin(
         open_lists/standard_scalar_open_list
 )
 
+fast_downward_plugin(
+    NAME BUCKET_TIEBREAKING_OPEN_LIST
+    HELP "Bucket-based tiebreaking open list"
+    SOURCES
+        open_lists/bucket_tiebreaking_open_list
+)
+
 fast_downward_plugin(
     NAME TIEBREAKING_OPEN_LIST
     HELP "Tiebreaking open list"
@@ -199,6 +207,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME MAPPED_SEGMENT_POOL
+    HELP "Memory pool in memory-mapped temporary files"
+    SOURCES
+        algorithms/mapped_segment_pool
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME MAX_CLIQUES
     HELP "Implementation of the Max Cliques algorithm by Tomita et al."
@@ -215,6 +231,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME MPSC_QUEUE
+    HELP "Lock-free queue for many producer threads and one consumer thread"
+    SOURCES
+        algorithms/mpsc_queue
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME ORDERED_SET
     HELP "Set of elements ordered by insertion time"
@@ -286,6 +310,14 @@ fast_downward_plugin(
     DEPENDS COMBINING_EVALUATOR EVALUATORS_PLUGIN_GROUP
 )
 
+fast_downward_plugin(
+    NAME PARALLEL_EVALUATOR
+    HELP "The parallel evaluator"
+    SOURCES
+        evaluators/parallel_evaluator
+    DEPENDS EVALUATORS_PLUGIN_GROUP
+)
+
 fast_downward_plugin(
     NAME PREF_EVALUATOR
     HELP "The pref evaluator"
@@ -348,7 +380,7 @@ fast_downward_plugin(
     HELP "Basic classes used for all search engines"
     SOURCES
         search_engines/search_common
-    DEPENDS ALTERNATION_OPEN_LIST G_EVALUATOR BOUNDED_G_EVALUATOR STANDARD_SCALAR_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
+    DEPENDS ALTERNATION_OPEN_LIST BUCKET_TIEBREAKING_OPEN_LIST G_EVALUATOR BOUNDED_G_EVALUATOR STANDARD_SCALAR_OPEN_LIST SUM_EVALUATOR TIEBREAKING_OPEN_LIST WEIGHTED_EVALUATOR
     DEPENDENCY_ONLY
 )
 
@@ -409,6 +441,14 @@ fast_downward_plugin(
     DEPENDS LAZY_SEARCH SEARCH_COMMON
 )
 
+fast_downward_plugin(
+    NAME HDA_ASTAR_SEARCH
+    HELP "Hash-distributed parallel A* search"
+    SOURCES
+        search_engines/hda_astar_search
+    DEPENDS MPSC_QUEUE SUCCESSOR_GENERATOR
+)
+
 fast_downward_plugin(
     NAME ENFORCED_HILL_CLIMBING_SEARCH
     HELP "Lazy enforced hill-climbing search algorithm"
@@ -526,16 +566,26 @@ fast_downward_plugin(
     NAME MAX_HEURISTIC
     HELP "The Max heuristic"
     SOURCES
+        heuristics/incremental_max_exploration
         heuristics/max_heuristic
     DEPENDS PRIORITY_QUEUES RELAXATION_HEURISTIC
 )
 
+fast_downward_plugin(
+    NAME UTILITY_BOUND_HEURISTIC
+    HELP "Relaxed upper bound on the reachable utility for OSP"
+    SOURCES
+        heuristics/utility_bound_heuristic
+    DEPENDS PRIORITY_QUEUES RELAXATION_HEURISTIC
+)
+
 fast_downward_plugin(
     NAME CORE_TASKS
     HELP "Core task transformations"
     SOURCES
         tasks/cost_adapted_task
         tasks/delegating_task
+        tasks/flattened_task
         tasks/root_task
     CORE_PLUGIN
 )
@@ -578,7 +628,7 @@ fast_downward_plugin(
     SOURCES
         task_utils/successor_generator
         task_utils/successor_generator_factory
-        task_utils/successor_generator_internals
+        task_utils/successor_generator_flat
     DEPENDS TASK_PROPERTIES
     DEPENDENCY_ONLY
 )
@@ -702,6 +752,7 @@ fast_downward_plugin(
     SOURCES
         pdbs/canonical_pdbs
         pdbs/canonical_pdbs_heuristic
+        pdbs/distance_table
         pdbs/dominance_pruning
         pdbs/incremental_canonical_pdbs
         pdbs/match_tree
@@ -717,6 +768,7 @@ fast_downward_plugin(
         pdbs/pattern_generator_greedy
         pdbs/pattern_generator_manual
         pdbs/pattern_generator
+        pdbs/pdb_factory
         pdbs/pdb_heuristic
         pdbs/plugin_group
         pdbs/types
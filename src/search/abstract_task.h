@@ -118,10 +118,25 @@ public:
         const AbstractTask *ancestor_task) const = 0;
 
     virtual int get_cost_bound() const = 0;
-    virtual std::vector<FactPairUtility> get_fact_pair_utilities() const = 0;
-    virtual std::map<int, std::map<int, int>> get_utilities_map() const = 0;
+    virtual const std::vector<FactPairUtility> &get_fact_pair_utilities() const = 0;
+    virtual const std::map<int, std::map<int, int>> &get_utilities_map() const = 0;
     virtual int get_state_utility(const GlobalState& state) const = 0;
 
+    /*
+      Utility of a single fact (0 for facts without a soft goal). This is a
+      constant-time lookup and allows computing the utility of a successor
+      state incrementally from the utility of its predecessor.
+    */
+    virtual int get_fact_utility(const FactPair &fact) const = 0;
+
+    /*
+      Equivalent to get_operator_cost(index, is_axiom, state) for any state
+      with the given utility. Tasks with utility-dependent operator costs
+      override this so that the search can evaluate such costs in O(1).
+    */
+    virtual int get_operator_cost_for_utility(
+        int index, bool is_axiom, int state_utility) const = 0;
+
     virtual int get_max_possible_utility() const = 0;
 
     // Get the bounded operator cost. Equivalent to the normal operator cost,
@@ -62,6 +62,23 @@ public:
         Bin &bin = buffer[bin_index];
         bin = (bin & clear_mask) | (value << shift);
     }
+
+    int get_bin_index() const {
+        return bin_index;
+    }
+
+    int get_shift() const {
+        return shift;
+    }
+
+    Bin get_clear_mask() const {
+        return clear_mask;
+    }
+
+    Bin get_value_bits(int value) const {
+        assert(value >= 0 && value < range);
+        return Bin(value) << shift;
+    }
 };
 
 
@@ -81,6 +98,22 @@ void IntPacker::set(Bin *buffer, int var, int value) const {
     var_infos[var].set(buffer, value);
 }
 
+int IntPacker::get_bin_index(int var) const {
+    return var_infos[var].get_bin_index();
+}
+
+int IntPacker::get_shift(int var) const {
+    return var_infos[var].get_shift();
+}
+
+IntPacker::Bin IntPacker::get_clear_mask(int var) const {
+    return var_infos[var].get_clear_mask();
+}
+
+IntPacker::Bin IntPacker::get_value_bits(int var, int value) const {
+    return var_infos[var].get_value_bits(value);
+}
+
 void IntPacker::pack_bins(const vector<int> &ranges) {
     assert(var_infos.empty());
 
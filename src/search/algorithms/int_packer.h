@@ -42,6 +42,19 @@ public:
     int get(const Bin *buffer, int var) const;
     void set(Bin *buffer, int var, int value) const;
 
+    /*
+      Low-level access to the layout, for code that precompiles
+      assignments into bin operations. set(buffer, var, value) is
+      equivalent to
+        bin = (bin & get_clear_mask(var)) | get_value_bits(var, value)
+      with bin = buffer[get_bin_index(var)], and get(buffer, var) is
+      (bin & ~get_clear_mask(var)) >> get_shift(var).
+    */
+    int get_bin_index(int var) const;
+    int get_shift(int var) const;
+    Bin get_clear_mask(int var) const;
+    Bin get_value_bits(int var, int value) const;
+
     int get_num_bins() const {return num_bins;}
 };
 }
@@ -0,0 +1,158 @@
+#include "mapped_segment_pool.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mapped_segment_pool {
+// Alignment of all allocations, sufficient for any fundamental type.
+static const size_t ALIGNMENT = alignof(max_align_t);
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static size_t round_up(size_t bytes, size_t multiple) {
+    return (bytes + multiple - 1) / multiple * multiple;
+}
+
+static size_t get_region_bytes(size_t region_bytes) {
+    size_t page_size = sysconf(_SC_PAGESIZE);
+    return round_up(max(region_bytes, size_t(1)), page_size);
+}
+
+static void exit_with_system_error(const string &msg, utils::ExitCode exit_code) {
+    cerr << msg << ": " << strerror(errno) << endl;
+    utils::exit_with(exit_code);
+}
+
+MappedSegmentPool::MappedSegmentPool(
+    const string &directory, size_t region_bytes, size_t max_resident_bytes)
+    : file_descriptor(-1),
+      region_bytes(get_region_bytes(region_bytes)),
+      max_resident_regions(max(max_resident_bytes / this->region_bytes, size_t(1))),
+      last_region_size(0),
+      num_released_regions(0) {
+    string path_template = directory + "/downward-states-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    file_descriptor = mkstemp(path.data());
+    if (file_descriptor == -1) {
+        exit_with_system_error(
+            "Could not create a state file in " + directory,
+            utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+    // The file stays accessible through the descriptor until it is closed.
+    unlink(path.data());
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+    for (char *region : regions) {
+        munmap(region, region_bytes);
+    }
+    close(file_descriptor);
+}
+
+void MappedSegmentPool::add_region() {
+    off_t offset = static_cast<off_t>(regions.size() * region_bytes);
+    /*
+      Reserve the disk space now: writing to a mapped page that has no
+      backing disk space would kill the planner with SIGBUS later on.
+    */
+#if OPERATING_SYSTEM == LINUX
+    int error = posix_fallocate(file_descriptor, offset, region_bytes);
+    if (error != 0) {
+        errno = error;
+        exit_with_system_error(
+            "Could not extend the state file", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+#else
+    if (ftruncate(file_descriptor, offset + region_bytes) == -1) {
+        exit_with_system_error(
+            "Could not extend the state file", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+#endif
+    void *region = mmap(nullptr, region_bytes, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, file_descriptor, offset);
+    if (region == MAP_FAILED) {
+        exit_with_system_error(
+            "Could not map the state file", utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    regions.push_back(static_cast<char *>(region));
+    last_region_size = 0;
+    release_cold_regions();
+}
+
+void MappedSegmentPool::release_cold_regions() {
+    if (regions.size() <= max_resident_regions)
+        return;
+    size_t num_cold_regions = regions.size() - max_resident_regions;
+    for (size_t i = 0; i < num_cold_regions; ++i) {
+        char *region = regions[i];
+        /*
+          Regions that became cold just now may contain data that has not
+          been written back yet. Older cold regions are only read, but
+          pages read since the last call are resident again.
+        */
+        if (i >= num_released_regions)
+            msync(region, region_bytes, MS_SYNC);
+        madvise(region, region_bytes, MADV_DONTNEED);
+#if OPERATING_SYSTEM == LINUX
+        posix_fadvise(file_descriptor, static_cast<off_t>(i * region_bytes),
+                      region_bytes, POSIX_FADV_DONTNEED);
+#endif
+    }
+    num_released_regions = num_cold_regions;
+}
+#else
+MappedSegmentPool::MappedSegmentPool(const string &, size_t region_bytes, size_t)
+    : file_descriptor(-1),
+      region_bytes(region_bytes),
+      max_resident_regions(0),
+      last_region_size(0),
+      num_released_regions(0) {
+    cerr << "Memory-mapped state storage is not supported on this "
+         << "operating system." << endl;
+    utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+}
+
+MappedSegmentPool::~MappedSegmentPool() {
+}
+
+void MappedSegmentPool::add_region() {
+}
+
+void MappedSegmentPool::release_cold_regions() {
+}
+#endif
+
+void *MappedSegmentPool::allocate(size_t bytes) {
+    bytes = (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    if (bytes > region_bytes) {
+        cerr << "Cannot allocate " << bytes << " bytes in memory-mapped regions of "
+             << region_bytes << " bytes." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    if (regions.empty() || last_region_size + bytes > region_bytes) {
+        add_region();
+    }
+    void *result = regions.back() + last_region_size;
+    last_region_size += bytes;
+    return result;
+}
+
+void MappedSegmentPool::print_statistics() const {
+    cout << "Memory-mapped state data: " << get_mapped_bytes() / (1024 * 1024)
+         << " MB in " << regions.size() << " region(s), "
+         << num_released_regions << " released from memory" << endl;
+}
+}
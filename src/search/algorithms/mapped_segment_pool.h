@@ -0,0 +1,144 @@
+#ifndef ALGORITHMS_MAPPED_SEGMENT_POOL_H
+#define ALGORITHMS_MAPPED_SEGMENT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+  MappedSegmentPool hands out memory from large regions of a temporary file
+  that is mapped into the address space. Data stored in the pool can be
+  paged out to disk by the operating system, so the pool can hold more data
+  than fits into RAM. Addresses handed out by the pool stay valid until the
+  pool is destroyed.
+
+  Memory is never returned to the pool before it is destroyed, which is
+  suitable for the segments of a SegmentedVector or SegmentedArrayVector:
+  these containers only free their segments in their destructor.
+
+  If max_resident_bytes is finite, the pool writes back all regions except
+  the most recently mapped ones whenever it maps a new region, and asks the
+  operating system to drop them from memory. Accessing data in such a region
+  transparently reads it back from disk, so this bounds the resident memory
+  of the pool only approximately, but keeps the most recently added data
+  (e.g. the states close to the search frontier) in RAM.
+
+  The temporary file is unlinked right after it is created, so it is removed
+  even if the planner is killed.
+*/
+
+namespace mapped_segment_pool {
+class MappedSegmentPool {
+    int file_descriptor;
+    const std::size_t region_bytes;
+    const std::size_t max_resident_regions;
+
+    std::vector<char *> regions;
+    // Number of bytes used in the last region.
+    std::size_t last_region_size;
+    // Regions with smaller indices have been released from memory.
+    std::size_t num_released_regions;
+
+    void add_region();
+    void release_cold_regions();
+
+    // No implementation to forbid copies and assignment
+    MappedSegmentPool(const MappedSegmentPool &);
+    MappedSegmentPool &operator=(const MappedSegmentPool &);
+public:
+    /*
+      Create the pool in a temporary file in the given directory. Both
+      sizes are in bytes. If the file cannot be created, the planner exits
+      with an error.
+    */
+    MappedSegmentPool(
+        const std::string &directory, std::size_t region_bytes,
+        std::size_t max_resident_bytes);
+    ~MappedSegmentPool();
+
+    void *allocate(std::size_t bytes);
+
+    std::size_t get_mapped_bytes() const {
+        return regions.size() * region_bytes;
+    }
+
+    void print_statistics() const;
+};
+
+
+/*
+  Allocator for the segmented vectors that takes its memory from a
+  MappedSegmentPool if it has one and from the heap otherwise. This allows
+  choosing the backing store at runtime without changing the type of the
+  container.
+*/
+template<class T>
+class MappedSegmentAllocator {
+    std::shared_ptr<MappedSegmentPool> pool;
+public:
+    typedef T value_type;
+    typedef T *pointer;
+    typedef const T *const_pointer;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template<class U>
+    struct rebind {
+        typedef MappedSegmentAllocator<U> other;
+    };
+
+    MappedSegmentAllocator() = default;
+
+    explicit MappedSegmentAllocator(const std::shared_ptr<MappedSegmentPool> &pool)
+        : pool(pool) {
+    }
+
+    template<class U>
+    MappedSegmentAllocator(const MappedSegmentAllocator<U> &other)
+        : pool(other.get_pool()) {
+    }
+
+    const std::shared_ptr<MappedSegmentPool> &get_pool() const {
+        return pool;
+    }
+
+    T *allocate(std::size_t n) {
+        if (pool)
+            return static_cast<T *>(pool->allocate(n * sizeof(T)));
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t) {
+        // Memory from the pool is released when the pool is destroyed.
+        if (!pool)
+            ::operator delete(p);
+    }
+
+    template<class U, class ... Args>
+    void construct(U *p, Args && ... args) {
+        ::new(static_cast<void *>(p))U(std::forward<Args>(args) ...);
+    }
+
+    template<class U>
+    void destroy(U *p) {
+        p->~U();
+    }
+
+    template<class U>
+    bool operator==(const MappedSegmentAllocator<U> &other) const {
+        return pool == other.get_pool();
+    }
+
+    template<class U>
+    bool operator!=(const MappedSegmentAllocator<U> &other) const {
+        return pool != other.get_pool();
+    }
+};
+}
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef ALGORITHMS_MPSC_QUEUE_H
+#define ALGORITHMS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace mpsc_queue {
+/*
+  Unbounded lock-free FIFO queue for many producer threads and a single
+  consumer thread (D. Vyukov's non-intrusive MPSC queue).
+
+  push() may be called concurrently from any thread. try_pop() must only
+  be called from the consumer thread. It can fail spuriously while a
+  concurrent push() is in progress, so consumers have to poll and must
+  not take an empty queue as proof that no element is pending.
+*/
+template<typename T>
+class MPSCQueue {
+    struct Node {
+        std::atomic<Node *> next;
+        T value;
+
+        Node() : next(nullptr) {
+        }
+
+        explicit Node(T &&value) : next(nullptr), value(std::move(value)) {
+        }
+    };
+
+    // Producers append at head; the consumer removes behind tail.
+    std::atomic<Node *> head;
+    Node *tail;
+public:
+    MPSCQueue() {
+        Node *stub = new Node();
+        head.store(stub, std::memory_order_relaxed);
+        tail = stub;
+    }
+
+    ~MPSCQueue() {
+        T value;
+        while (try_pop(value)) {
+        }
+        delete tail;
+    }
+
+    MPSCQueue(const MPSCQueue &) = delete;
+    MPSCQueue &operator=(const MPSCQueue &) = delete;
+
+    void push(T value) {
+        Node *node = new Node(std::move(value));
+        Node *prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    bool try_pop(T &value) {
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+        value = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+}
+
+#endif
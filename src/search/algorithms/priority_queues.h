@@ -3,8 +3,11 @@
 
 #include "../utils/collections.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
+#include <limits>
+#include <map>
 #include <queue>
 #include <utility>
 #include <vector>
@@ -24,6 +27,9 @@
   function calls and do some additional inlining. The class has the
   same interface as AbstractQueue, however, to facilitate swapping the
   different implementations in and out.
+
+  PairBucketQueue is a separate two-level bucket queue whose entries are
+  ordered lexicographically by a pair of keys (see below).
  */
 namespace priority_queues {
 template<typename Value>
@@ -267,6 +273,160 @@ public:
         wrapped_queue->add_virtual_pushes(num_extra_pushes);
     }
 };
+
+
+/*
+  PairBucketQueue orders its entries lexicographically by a pair of
+  non-negative keys, as needed for explorations over primary and secondary
+  (bounded) costs. It has one bucket per primary key, each of which is
+  divided into one bucket per secondary key, so memory is proportional to
+  the key ranges that occur.
+
+  Buckets are never deallocated and clear() only starts a new generation:
+  buckets of older generations are emptied lazily when they are used
+  again. Reusing the queue for many explorations therefore neither
+  allocates memory nor visits all buckets on every reset.
+
+  At most MAX_DENSE_BUCKETS buckets (primary and secondary) are allocated.
+  Entries that would need more, e.g. because of large key ranges, are
+  kept in a map instead, so that memory and the work of pop() stay
+  bounded.
+*/
+template<typename Value>
+class PairBucketQueue {
+    static const int MAX_DENSE_BUCKETS = 1 << 20;
+
+    typedef std::pair<int, int> Key;
+
+    struct Bucket {
+        int generation;
+        int current_secondary_key;
+        int num_entries;
+        std::vector<std::vector<Value>> secondary_buckets;
+
+        Bucket()
+            : generation(-1), current_secondary_key(0), num_entries(0) {
+        }
+    };
+
+    std::vector<Bucket> buckets;
+    std::map<Key, std::vector<Value>> sparse_buckets;
+    int num_dense_buckets;
+    int generation;
+    int current_key;
+    int num_dense_entries;
+
+    bool is_dense(int key, int secondary_key) const {
+        if (key >= MAX_DENSE_BUCKETS || secondary_key >= MAX_DENSE_BUCKETS)
+            return false;
+        int num_buckets = buckets.size();
+        int num_new_buckets;
+        if (key < num_buckets) {
+            int num_secondary_buckets = buckets[key].secondary_buckets.size();
+            num_new_buckets = std::max(0, secondary_key + 1 - num_secondary_buckets);
+        } else {
+            num_new_buckets = (key + 1 - num_buckets) + (secondary_key + 1);
+        }
+        return num_dense_buckets + num_new_buckets <= MAX_DENSE_BUCKETS;
+    }
+
+    bool is_empty_bucket(const Bucket &bucket) const {
+        return bucket.generation != generation || bucket.num_entries == 0;
+    }
+
+    Key find_min_dense_key() {
+        assert(num_dense_entries > 0);
+        while (is_empty_bucket(buckets[current_key]))
+            ++current_key;
+        Bucket &bucket = buckets[current_key];
+        while (bucket.secondary_buckets[bucket.current_secondary_key].empty())
+            ++bucket.current_secondary_key;
+        return std::make_pair(current_key, bucket.current_secondary_key);
+    }
+public:
+    typedef std::pair<Key, Value> Entry;
+
+    PairBucketQueue()
+        : num_dense_buckets(0),
+          generation(0),
+          current_key(std::numeric_limits<int>::max()),
+          num_dense_entries(0) {
+    }
+
+    void push(int key, int secondary_key, const Value &value) {
+        assert(key >= 0 && secondary_key >= 0);
+        if (!is_dense(key, secondary_key)) {
+            sparse_buckets[std::make_pair(key, secondary_key)].push_back(value);
+            return;
+        }
+        if (key >= static_cast<int>(buckets.size())) {
+            num_dense_buckets += key + 1 - buckets.size();
+            buckets.resize(key + 1);
+        }
+        Bucket &bucket = buckets[key];
+        if (bucket.generation != generation) {
+            for (std::vector<Value> &secondary_bucket : bucket.secondary_buckets)
+                secondary_bucket.clear();
+            bucket.generation = generation;
+            bucket.current_secondary_key = std::numeric_limits<int>::max();
+            bucket.num_entries = 0;
+        }
+        if (secondary_key >= static_cast<int>(bucket.secondary_buckets.size())) {
+            num_dense_buckets +=
+                secondary_key + 1 - bucket.secondary_buckets.size();
+            bucket.secondary_buckets.resize(secondary_key + 1);
+        }
+        bucket.secondary_buckets[secondary_key].push_back(value);
+        ++bucket.num_entries;
+        ++num_dense_entries;
+        if (secondary_key < bucket.current_secondary_key)
+            bucket.current_secondary_key = secondary_key;
+        if (key < current_key)
+            current_key = key;
+    }
+
+    Entry pop() {
+        assert(!empty());
+        if (num_dense_entries == 0 ||
+            (!sparse_buckets.empty() &&
+             sparse_buckets.begin()->first < find_min_dense_key())) {
+            auto it = sparse_buckets.begin();
+            std::vector<Value> &sparse_bucket = it->second;
+            Entry result = std::make_pair(it->first, sparse_bucket.back());
+            sparse_bucket.pop_back();
+            if (sparse_bucket.empty())
+                sparse_buckets.erase(it);
+            return result;
+        }
+        Key min_key = find_min_dense_key();
+        Bucket &bucket = buckets[min_key.first];
+        std::vector<Value> &secondary_bucket =
+            bucket.secondary_buckets[min_key.second];
+        Value top_element = secondary_bucket.back();
+        secondary_bucket.pop_back();
+        --bucket.num_entries;
+        --num_dense_entries;
+        return std::make_pair(min_key, top_element);
+    }
+
+    bool empty() const {
+        return num_dense_entries == 0 && sparse_buckets.empty();
+    }
+
+    void clear() {
+        sparse_buckets.clear();
+        num_dense_entries = 0;
+        current_key = std::numeric_limits<int>::max();
+        if (++generation == std::numeric_limits<int>::max()) {
+            for (Bucket &bucket : buckets)
+                bucket.generation = -1;
+            generation = 0;
+        }
+    }
+};
+
+template<typename Value>
+const int PairBucketQueue<Value>::MAX_DENSE_BUCKETS;
 }
 
 #endif
@@ -2,6 +2,7 @@
 #define ALGORITHMS_SUBSCRIBER_H
 
 #include <cassert>
+#include <mutex>
 #include <unordered_set>
 
 /*
@@ -74,6 +75,12 @@ class SubscriberService {
       to subscribe to const objects is very useful in the planner.
     */
     mutable std::unordered_set<Subscriber<T> *> subscribers;
+    /*
+      Different subscribers may (un)subscribe concurrently, e.g., per-thread
+      evaluators that store information for states of the same registry.
+      A single subscriber must not be used from several threads at once.
+    */
+    mutable std::mutex subscribers_mutex;
 public:
     virtual ~SubscriberService() {
         /*
@@ -88,6 +95,7 @@ public:
     }
 
     void subscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::mutex> lock(subscribers_mutex);
         assert(subscribers.find(subscriber) == subscribers.end());
         subscribers.insert(subscriber);
         assert(subscriber->services.find(this) == subscriber->services.end());
@@ -95,6 +103,7 @@ public:
     }
 
     void unsubscribe(Subscriber<T> *subscriber) const {
+        std::lock_guard<std::mutex> lock(subscribers_mutex);
         assert(subscribers.find(subscriber) != subscribers.end());
         subscribers.erase(subscriber);
         assert(subscriber->services.find(this) != subscriber->services.end());
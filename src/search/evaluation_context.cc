@@ -45,6 +45,16 @@ const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     return result;
 }
 
+void EvaluationContext::set_result(Evaluator *evaluator, EvaluationResult &&result) {
+    assert(!result.is_uninitialized());
+    if (statistics &&
+        evaluator->is_used_for_counting_evaluations() &&
+        result.get_count_evaluation()) {
+        statistics->inc_evaluations();
+    }
+    cache[evaluator] = move(result);
+}
+
 const EvaluatorCache &EvaluationContext::get_cache() const {
     return cache;
 }
@@ -86,6 +86,12 @@ public:
     ~EvaluationContext() = default;
 
     const EvaluationResult &get_result(Evaluator *eval);
+    /*
+      Store a result for eval that has been computed without calling
+      get_result, e.g., by another thread. Evaluations are counted as in
+      get_result.
+    */
+    void set_result(Evaluator *eval, EvaluationResult &&result);
     const EvaluatorCache &get_cache() const;
     const GlobalState &get_state() const;
     int get_g_value() const;
@@ -1,5 +1,6 @@
 #include "evaluator.h"
 
+#include "evaluation_context.h"
 #include "plugin.h"
 
 #include "utils/system.h"
@@ -23,6 +24,11 @@ bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
 
+void Evaluator::compute_results(const vector<EvaluationContext *> &eval_contexts) {
+    for (EvaluationContext *eval_context : eval_contexts)
+        eval_context->get_result(this);
+}
+
 void Evaluator::report_value_for_initial_state(const EvaluationResult &result) const {
     assert(use_for_reporting_minima);
     cout << "Initial heuristic value for " << description << ": ";
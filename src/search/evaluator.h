@@ -4,6 +4,7 @@
 #include "evaluation_result.h"
 
 #include <set>
+#include <vector>
 
 class EvaluationContext;
 class GlobalState;
@@ -30,6 +31,19 @@ public:
     */
     virtual bool dead_ends_are_reliable() const;
 
+    /*
+      depends_on_cost_bound should return true if the value depends on the
+      remaining secondary cost bound of the evaluation context, i.e., the
+      cost bound of the task minus the bounded g value. Such values must
+      be non-increasing in the remaining bound. Values of these evaluators
+      must not be cached for a state independently of the bound.
+
+      The default implementation returns false.
+    */
+    virtual bool depends_on_cost_bound() const {
+        return false;
+    }
+
     /*
       get_path_dependent_evaluators should insert all path-dependent
       evaluators that this evaluator directly or indirectly depends on
@@ -44,6 +58,19 @@ public:
         std::set<Evaluator *> &evals) = 0;
 
 
+    /*
+      get_batch_evaluators should insert all evaluators that this
+      evaluator directly or indirectly depends on and that evaluate
+      several states more efficiently together than one after the other,
+      including itself if necessary. Search algorithms that generate
+      several states at once call compute_results for these and only
+      these evaluators before evaluating the states.
+
+      The default implementation inserts nothing.
+    */
+    virtual void get_batch_evaluators(std::set<Evaluator *> & /*evals*/) {
+    }
+
     virtual void notify_initial_state(const GlobalState & /*initial_state*/) {
     }
 
@@ -76,6 +103,18 @@ public:
     virtual EvaluationResult compute_result(
         EvaluationContext &eval_context) = 0;
 
+    /*
+      compute_results should compute the results for all given evaluation
+      contexts, which belong to different states, and store them in the
+      contexts, so that later calls of EvaluationContext::get_result for
+      this evaluator do not compute them again.
+
+      The default implementation evaluates the contexts one after the
+      other.
+    */
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts);
+
     void report_value_for_initial_state(const EvaluationResult &result) const;
     void report_new_minimum_value(const EvaluationResult &result) const;
 
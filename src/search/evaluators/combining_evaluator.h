@@ -42,6 +42,7 @@ public:
 
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(std::set<Evaluator *> &evals) override;
 };
 }
 
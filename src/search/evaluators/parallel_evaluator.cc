@@ -0,0 +1,201 @@
+#include "parallel_evaluator.h"
+
+#include "../evaluation_context.h"
+#include "../evaluation_result.h"
+#include "../option_parser.h"
+#include "../option_parser_util.h"
+#include "../plugin.h"
+
+#include "../options/predefinitions.h"
+#include "../utils/parallel.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace parallel_evaluator {
+const int ParallelEvaluator::NO_VALUE;
+
+static vector<Evaluator *> get_path_dependent_instances(
+    const vector<shared_ptr<Evaluator>> &evaluators) {
+    set<Evaluator *> evals;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+    return vector<Evaluator *>(evals.begin(), evals.end());
+}
+
+ParallelEvaluator::ParallelEvaluator(
+    const Options &opts, const vector<shared_ptr<Evaluator>> &evaluators)
+    : Evaluator(opts.get_unparsed_config(), true, true, true),
+      evaluators(evaluators),
+      path_dependent_evaluators(get_path_dependent_instances(evaluators)),
+      cache_values(evaluators[0]->does_cache_estimates() &&
+                   path_dependent_evaluators.empty() &&
+                   !evaluators[0]->depends_on_cost_bound()),
+      value_cache(NO_VALUE) {
+}
+
+ParallelEvaluator::~ParallelEvaluator() {
+}
+
+bool ParallelEvaluator::is_cached(const EvaluationContext &eval_context) const {
+    // Preferred operators are not cached.
+    return cache_values && !eval_context.get_calculate_preferred() &&
+           value_cache[eval_context.get_state()] != NO_VALUE;
+}
+
+EvaluationResult ParallelEvaluator::get_cached_result(const GlobalState &state) const {
+    EvaluationResult result;
+    result.set_evaluator_value(value_cache[state]);
+    result.set_count_evaluation(false);
+    return result;
+}
+
+EvaluationResult ParallelEvaluator::evaluate(
+    Evaluator &evaluator, const EvaluationContext &eval_context) const {
+    /*
+      Evaluate in a separate context without statistics, since the
+      statistics are shared by all threads. The evaluation is counted
+      for this evaluator when the result is stored in eval_context.
+    */
+    EvaluationContext local_context(
+        eval_context.get_state(), eval_context.get_g_value(),
+        eval_context.is_preferred(), nullptr,
+        eval_context.get_calculate_preferred(),
+        eval_context.get_bounded_g_value());
+    return local_context.get_result(&evaluator);
+}
+
+bool ParallelEvaluator::does_cache_estimates() const {
+    return cache_values;
+}
+
+bool ParallelEvaluator::is_estimate_cached(const GlobalState &state) const {
+    return cache_values && value_cache[state] != NO_VALUE;
+}
+
+int ParallelEvaluator::get_cached_estimate(const GlobalState &state) const {
+    assert(is_estimate_cached(state));
+    return value_cache[state];
+}
+
+bool ParallelEvaluator::dead_ends_are_reliable() const {
+    return evaluators[0]->dead_ends_are_reliable();
+}
+
+bool ParallelEvaluator::depends_on_cost_bound() const {
+    return evaluators[0]->depends_on_cost_bound();
+}
+
+EvaluationResult ParallelEvaluator::compute_result(
+    EvaluationContext &eval_context) {
+    if (is_cached(eval_context))
+        return get_cached_result(eval_context.get_state());
+    EvaluationResult result = evaluate(*evaluators[0], eval_context);
+    if (cache_values)
+        value_cache[eval_context.get_state()] = result.get_evaluator_value();
+    return result;
+}
+
+void ParallelEvaluator::compute_results(
+    const vector<EvaluationContext *> &eval_contexts) {
+    vector<EvaluationContext *> uncached_contexts;
+    for (EvaluationContext *eval_context : eval_contexts) {
+        if (is_cached(*eval_context)) {
+            eval_context->set_result(
+                this, get_cached_result(eval_context->get_state()));
+        } else {
+            uncached_contexts.push_back(eval_context);
+        }
+    }
+
+    int num_contexts = uncached_contexts.size();
+    int num_threads = min(static_cast<int>(evaluators.size()), num_contexts);
+    vector<EvaluationResult> results(num_contexts);
+    // Work item t evaluates every num_threads-th context with instance t.
+    utils::parallel_for(
+        num_threads, num_threads, [&](int thread_id) {
+            Evaluator &evaluator = *evaluators[thread_id];
+            for (int i = thread_id; i < num_contexts; i += num_threads) {
+                results[i] = evaluate(evaluator, *uncached_contexts[i]);
+            }
+        });
+
+    // The cache is not thread-safe, so it is only updated here.
+    for (int i = 0; i < num_contexts; ++i) {
+        if (cache_values) {
+            value_cache[uncached_contexts[i]->get_state()] =
+                results[i].get_evaluator_value();
+        }
+        uncached_contexts[i]->set_result(this, move(results[i]));
+    }
+}
+
+void ParallelEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
+    if (!path_dependent_evaluators.empty())
+        evals.insert(this);
+}
+
+void ParallelEvaluator::get_batch_evaluators(set<Evaluator *> &evals) {
+    evals.insert(this);
+}
+
+void ParallelEvaluator::notify_initial_state(const GlobalState &initial_state) {
+    for (Evaluator *evaluator : path_dependent_evaluators)
+        evaluator->notify_initial_state(initial_state);
+}
+
+void ParallelEvaluator::notify_state_transition(
+    const GlobalState &parent_state, OperatorID op_id,
+    const GlobalState &state) {
+    for (Evaluator *evaluator : path_dependent_evaluators)
+        evaluator->notify_state_transition(parent_state, op_id, state);
+}
+
+static shared_ptr<Evaluator> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Parallel evaluator",
+        "Evaluates batches of states concurrently with one instance of the "
+        "given evaluator per thread. Single states are evaluated as usual. "
+        "Currently, only eager search (eager, eager_greedy and astar) "
+        "evaluates the new successors of an expansion as a batch.");
+    parser.document_note(
+        "Evaluator instances",
+        "The evaluator specification is parsed once per thread, so expensive "
+        "precomputations (e.g., of merge-and-shrink) are repeated per thread. "
+        "Evaluators predefined with --evaluator cannot be used inside, since "
+        "all threads would share the same instance. The evaluator must not "
+        "modify data shared between instances during evaluation.");
+    parser.add_option<ParseTree>("eval", "evaluator");
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads and evaluator instances",
+        "2",
+        Bounds("1", "infinity"));
+    Options opts = parser.parse();
+
+    if (parser.help_mode())
+        return nullptr;
+
+    /*
+      Predefined evaluators are not available, since their instances would
+      be shared by all threads.
+    */
+    options::Predefinitions no_predefinitions;
+    int num_instances = parser.dry_run() ? 1 : opts.get<int>("num_threads");
+    vector<shared_ptr<Evaluator>> evaluators;
+    for (int i = 0; i < num_instances; ++i) {
+        OptionParser eval_parser(opts.get<ParseTree>("eval"), parser.get_registry(),
+                                 no_predefinitions, parser.dry_run());
+        evaluators.push_back(eval_parser.start_parsing<shared_ptr<Evaluator>>());
+    }
+
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<ParallelEvaluator>(opts, evaluators);
+}
+
+static Plugin<Evaluator> _plugin("parallel", _parse, "evaluators_basic");
+}
@@ -0,0 +1,69 @@
+#ifndef EVALUATORS_PARALLEL_EVALUATOR_H
+#define EVALUATORS_PARALLEL_EVALUATOR_H
+
+#include "../evaluator.h"
+#include "../per_state_information.h"
+
+#include <memory>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace parallel_evaluator {
+/*
+  Evaluates batches of states concurrently with one instance of the
+  wrapped evaluator per thread. Each instance is only used by one thread
+  at a time. Single states are evaluated with the first instance.
+
+  All instances are notified about the initial state and all state
+  transitions, so path-dependent evaluators are supported.
+*/
+class ParallelEvaluator : public Evaluator {
+    std::vector<std::shared_ptr<Evaluator>> evaluators;
+    // Path-dependent evaluators of all instances, notified by this evaluator.
+    std::vector<Evaluator *> path_dependent_evaluators;
+
+    /*
+      The caches of the instances only contain the states each instance
+      evaluated, so values are cached here instead. This is only done if
+      the instances cache their values and the values only depend on the
+      state, i.e., not on the path or the remaining cost bound.
+    */
+    static const int NO_VALUE = -2;
+    const bool cache_values;
+    PerStateInformation<int> value_cache;
+
+    bool is_cached(const EvaluationContext &eval_context) const;
+    EvaluationResult get_cached_result(const GlobalState &state) const;
+    EvaluationResult evaluate(
+        Evaluator &evaluator, const EvaluationContext &eval_context) const;
+public:
+    ParallelEvaluator(
+        const options::Options &opts,
+        const std::vector<std::shared_ptr<Evaluator>> &evaluators);
+    virtual ~ParallelEvaluator() override;
+
+    virtual bool dead_ends_are_reliable() const override;
+    virtual bool depends_on_cost_bound() const override;
+    virtual EvaluationResult compute_result(
+        EvaluationContext &eval_context) override;
+    virtual void compute_results(
+        const std::vector<EvaluationContext *> &eval_contexts) override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(std::set<Evaluator *> &evals) override;
+    virtual void notify_initial_state(const GlobalState &initial_state) override;
+    virtual void notify_state_transition(
+        const GlobalState &parent_state, OperatorID op_id,
+        const GlobalState &state) override;
+
+    virtual bool does_cache_estimates() const override;
+    virtual bool is_estimate_cached(const GlobalState &state) const override;
+    virtual int get_cached_estimate(const GlobalState &state) const override;
+};
+}
+
+#endif
@@ -44,6 +44,10 @@ void WeightedEvaluator::get_path_dependent_evaluators(set<Evaluator *> &evals) {
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+void WeightedEvaluator::get_batch_evaluators(set<Evaluator *> &evals) {
+    evaluator->get_batch_evaluators(evals);
+}
+
 static shared_ptr<Evaluator> _parse(OptionParser &parser) {
     parser.document_synopsis(
         "Weighted evaluator",
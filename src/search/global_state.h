@@ -8,6 +8,10 @@
 class State;
 class StateRegistry;
 
+namespace successor_generator {
+class FlatGenerator;
+}
+
 using PackedStateBin = int_packer::IntPacker::Bin;
 
 // For documentation on classes relevant to storing and working with registered
@@ -19,6 +23,7 @@ class GlobalState {
     template<typename>
     friend class PerStateArray;
     friend class PerStateBitset;
+    friend class successor_generator::FlatGenerator;
 
     // Values for vars are maintained in a packed state and accessed on demand.
     const PackedStateBin *buffer;
@@ -9,6 +9,7 @@
 #include "tasks/cost_adapted_task.h"
 #include "tasks/root_task.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <limits>
@@ -17,7 +18,10 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts.get_unparsed_config(), true, true, true),
+      valid_min_bound(0),
+      valid_max_bound(0),
       heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
+      bounded_heuristic_cache(BoundedHEntry(NO_VALUE, 0, -1)),
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
@@ -30,6 +34,34 @@ void Heuristic::set_preferred(const OperatorProxy &op) {
     preferred_operators.insert(op.get_ancestor_operator_id(tasks::g_root_task.get()));
 }
 
+void Heuristic::set_valid_bounds(int min_bound, int max_bound) {
+    assert(min_bound <= valid_min_bound && valid_max_bound <= max_bound);
+    valid_min_bound = min_bound;
+    valid_max_bound = max_bound;
+}
+
+bool Heuristic::is_cached_for_bound(const GlobalState &state, int cost_bound) const {
+    const BoundedHEntry &entry = bounded_heuristic_cache[state];
+    return entry.h != NO_VALUE &&
+           entry.min_bound <= cost_bound && cost_bound <= entry.max_bound;
+}
+
+void Heuristic::cache_for_bound(const GlobalState &state, int h) {
+    // Bounds under which the state is a dead end include all smaller bounds.
+    int min_bound = (h == DEAD_END) ? numeric_limits<int>::min() : valid_min_bound;
+    BoundedHEntry &entry = bounded_heuristic_cache[state];
+    if (entry.h == h) {
+        /*
+          The value is the same at both intervals and non-increasing in the
+          bound, so it is also the same for all bounds in between.
+        */
+        entry.min_bound = min(entry.min_bound, min_bound);
+        entry.max_bound = max(entry.max_bound, valid_max_bound);
+    } else {
+        entry = BoundedHEntry(h, min_bound, valid_max_bound);
+    }
+}
+
 State Heuristic::convert_global_state(const GlobalState &global_state) const {
     return task_proxy.convert_ancestor_state(global_state.unpack());
 }
@@ -52,17 +84,26 @@ EvaluationResult Heuristic::compute_result(EvaluationContext &eval_context) {
     bool calculate_preferred = eval_context.get_calculate_preferred();
 
     int heuristic = NO_VALUE;
+    int cost_bound = task_proxy.get_cost_bound() - eval_context.get_bounded_g_value();
+    bool bounded = depends_on_cost_bound();
 
-    if (!calculate_preferred && cache_evaluator_values &&
-        heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
+    if (!calculate_preferred && cache_evaluator_values && bounded &&
+        is_cached_for_bound(state, cost_bound)) {
+        heuristic = bounded_heuristic_cache[state].h;
+        result.set_count_evaluation(false);
+    } else if (!calculate_preferred && cache_evaluator_values && !bounded &&
+               heuristic_cache[state].h != NO_VALUE && !heuristic_cache[state].dirty) {
         heuristic = heuristic_cache[state].h;
         result.set_count_evaluation(false);
     } else {
-      // heuristic = compute_heuristic(state);
-      heuristic = compute_heuristic_w_bound(
-	  state, task_proxy.get_cost_bound() - eval_context.get_bounded_g_value());
+        valid_min_bound = cost_bound;
+        valid_max_bound = cost_bound;
+        heuristic = compute_heuristic_w_bound(state, cost_bound);
         if (cache_evaluator_values) {
-            heuristic_cache[state] = HEntry(heuristic, false);
+            if (bounded)
+                cache_for_bound(state, heuristic);
+            else
+                heuristic_cache[state] = HEntry(heuristic, false);
         }
         result.set_count_evaluation(true);
     }
@@ -103,10 +144,14 @@ bool Heuristic::does_cache_estimates() const {
 }
 
 bool Heuristic::is_estimate_cached(const GlobalState &state) const {
+    if (depends_on_cost_bound())
+        return bounded_heuristic_cache[state].h != NO_VALUE;
     return heuristic_cache[state].h != NO_VALUE;
 }
 
 int Heuristic::get_cached_estimate(const GlobalState &state) const {
     assert(is_estimate_cached(state));
+    if (depends_on_cost_bound())
+        return bounded_heuristic_cache[state].h;
     return heuristic_cache[state].h;
 }
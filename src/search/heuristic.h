@@ -31,6 +31,28 @@ class Heuristic : public Evaluator {
     };
     static_assert(sizeof(HEntry) == 4, "HEntry has unexpected size.");
 
+    /*
+      Cache entry of heuristics whose value depends on the remaining
+      secondary cost bound: h is the value for all remaining bounds in
+      [min_bound, max_bound].
+    */
+    struct BoundedHEntry {
+        int h;
+        int min_bound;
+        int max_bound;
+
+        BoundedHEntry(int h, int min_bound, int max_bound)
+            : h(h), min_bound(min_bound), max_bound(max_bound) {
+        }
+    };
+
+    // Bounds for which the value computed last is valid (see set_valid_bounds).
+    int valid_min_bound;
+    int valid_max_bound;
+
+    bool is_cached_for_bound(const GlobalState &state, int cost_bound) const;
+    void cache_for_bound(const GlobalState &state, int h);
+
     /*
       TODO: We might want to get rid of the preferred_operators
       attribute. It is currently only used by compute_result() and the
@@ -52,6 +74,11 @@ protected:
       entries for all existing states
     */
     PerStateInformation<HEntry> heuristic_cache;
+    /*
+      Cache for heuristics whose values depend on the remaining bound
+      (see depends_on_cost_bound). It is used instead of heuristic_cache.
+    */
+    PerStateInformation<BoundedHEntry> bounded_heuristic_cache;
     bool cache_evaluator_values;
 
     // Hold a reference to the task implementation and pass it to objects that need it.
@@ -69,6 +96,21 @@ protected:
       return compute_heuristic(state);
     };
 
+    /*
+      Heuristics whose values depend on the remaining bound (see
+      Evaluator::depends_on_cost_bound) cache a value for the interval of
+      bounds for which it is known to be valid, and recompute it for other
+      bounds. Since the values are monotone, the interval spans all bounds
+      under which the same value has been computed, and dead ends are
+      valid for all smaller bounds.
+
+      compute_heuristic_w_bound may call this to report that the value it
+      computes is valid for all remaining bounds in [min_bound, max_bound],
+      which has to include the given bound. By default, the value is only
+      known to be valid for the given bound.
+    */
+    void set_valid_bounds(int min_bound, int max_bound);
+
     /*
       Usage note: Marking the same operator as preferred multiple times
       is OK -- it will only appear once in the list of preferred
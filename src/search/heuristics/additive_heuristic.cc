@@ -6,6 +6,7 @@
 
 #include "../task_utils/task_properties.h"
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
 
@@ -38,69 +39,57 @@ void AdditiveHeuristic::write_overflow_warning() {
 void AdditiveHeuristic::setup_exploration_queue() {
     queue.clear();
 
-    for (size_t var = 0; var < propositions.size(); ++var) {
-        for (size_t value = 0; value < propositions[var].size(); ++value) {
-            Proposition &prop = propositions[var][value];
-            prop.cost = -1;
-            prop.marked = false;
-        }
-    }
+    reset_proposition_costs();
+    fill(prop_marked.begin(), prop_marked.end(), false);
 
     // Deal with operators and axioms without preconditions.
-    for (size_t i = 0; i < unary_operators.size(); ++i) {
-        UnaryOperator &op = unary_operators[i];
-        op.unsatisfied_preconditions = op.precondition.size();
-        op.cost = op.base_cost; // will be increased by precondition costs
-
-        if (op.unsatisfied_preconditions == 0)
-            enqueue_if_necessary(op.effect, op.base_cost, &op);
+    reset_unary_operators();
+    for (OpID op_id = 0; op_id < num_unary_operators; ++op_id) {
+        if (op_unsatisfied_preconditions[op_id] == 0)
+            enqueue_if_necessary(op_effect[op_id], op_base_cost[op_id], op_id);
     }
 }
 
 void AdditiveHeuristic::setup_exploration_queue_state(const State &state) {
     for (FactProxy fact : state) {
-        Proposition *init_prop = get_proposition(fact);
-        enqueue_if_necessary(init_prop, 0, 0);
+        PropID init_prop = get_prop_id(fact);
+        enqueue_if_necessary(init_prop, 0, NO_OP);
     }
 }
 
 void AdditiveHeuristic::relaxed_exploration() {
     int unsolved_goals = goal_propositions.size();
     while (!queue.empty()) {
-        pair<int, Proposition *> top_pair = queue.pop();
+        pair<int, PropID> top_pair = queue.pop();
         int distance = top_pair.first;
-        Proposition *prop = top_pair.second;
-        int prop_cost = prop->cost;
-        assert(prop_cost >= 0);
-        assert(prop_cost <= distance);
-        if (prop_cost < distance)
+        PropID prop_id = top_pair.second;
+        int cost = prop_cost[prop_id];
+        assert(cost >= 0);
+        assert(cost <= distance);
+        if (cost < distance)
             continue;
-        if (prop->is_goal && --unsolved_goals == 0)
+        if (prop_is_goal[prop_id] && --unsolved_goals == 0)
             return;
-        const vector<UnaryOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (size_t i = 0; i < triggered_operators.size(); ++i) {
-            UnaryOperator *unary_op = triggered_operators[i];
-            increase_cost(unary_op->cost, prop_cost);
-            --unary_op->unsatisfied_preconditions;
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0)
-                enqueue_if_necessary(unary_op->effect,
-                                     unary_op->cost, unary_op);
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            increase_cost(op_cost[op_id], cost);
+            --op_unsatisfied_preconditions[op_id];
+            assert(op_unsatisfied_preconditions[op_id] >= 0);
+            if (op_unsatisfied_preconditions[op_id] == 0)
+                enqueue_if_necessary(op_effect[op_id], op_cost[op_id], op_id);
         }
     }
 }
 
 void AdditiveHeuristic::mark_preferred_operators(
-    const State &state, Proposition *goal) {
-    if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
-        UnaryOperator *unary_op = goal->reached_by;
-        if (unary_op) { // We have not yet chained back to a start node.
-            for (size_t i = 0; i < unary_op->precondition.size(); ++i)
-                mark_preferred_operators(state, unary_op->precondition[i]);
-            int operator_no = unary_op->operator_no;
-            if (unary_op->cost == unary_op->base_cost && operator_no != -1) {
+    const State &state, PropID goal_id) {
+    if (!prop_marked[goal_id]) { // Only consider each subgoal once.
+        prop_marked[goal_id] = true;
+        OpID op_id = prop_reached_by[goal_id];
+        if (op_id != NO_OP) { // We have not yet chained back to a start node.
+            for (PropID precond : get_preconditions(op_id))
+                mark_preferred_operators(state, precond);
+            int operator_no = op_operator_no[op_id];
+            if (op_cost[op_id] == op_base_cost[op_id] && operator_no != -1) {
                 // Necessary condition for this being a preferred
                 // operator, which we use as a quick test before the
                 // more expensive applicability test.
@@ -120,11 +109,11 @@ int AdditiveHeuristic::compute_add_and_ff(const State &state) {
     relaxed_exploration();
 
     int total_cost = 0;
-    for (size_t i = 0; i < goal_propositions.size(); ++i) {
-        int prop_cost = goal_propositions[i]->cost;
-        if (prop_cost == -1)
+    for (PropID goal_id : goal_propositions) {
+        int goal_cost = prop_cost[goal_id];
+        if (goal_cost == -1)
             return DEAD_END;
-        increase_cost(total_cost, prop_cost);
+        increase_cost(total_cost, goal_cost);
     }
     return total_cost;
 }
@@ -132,8 +121,8 @@ int AdditiveHeuristic::compute_add_and_ff(const State &state) {
 int AdditiveHeuristic::compute_heuristic(const State &state) {
     int h = compute_add_and_ff(state);
     if (h != DEAD_END) {
-        for (size_t i = 0; i < goal_propositions.size(); ++i)
-            mark_preferred_operators(state, goal_propositions[i]);
+        for (PropID goal_id : goal_propositions)
+            mark_preferred_operators(state, goal_id);
     }
     return h;
 }
@@ -4,15 +4,16 @@
 #include "relaxation_heuristic.h"
 
 #include "../algorithms/priority_queues.h"
-#include "../utils/collections.h"
 
 #include <cassert>
 
 class State;
 
 namespace additive_heuristic {
-using relaxation_heuristic::Proposition;
-using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::PropID;
+using relaxation_heuristic::OpID;
+
+using relaxation_heuristic::NO_OP;
 
 class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
     /* Costs larger than MAX_COST_VALUE are clamped to max_value. The
@@ -24,22 +25,23 @@ class AdditiveHeuristic : public relaxation_heuristic::RelaxationHeuristic {
      */
     static const int MAX_COST_VALUE = 100000000;
 
-    priority_queues::AdaptiveQueue<Proposition *> queue;
+    priority_queues::AdaptiveQueue<PropID> queue;
     bool did_write_overflow_warning;
 
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration();
-    void mark_preferred_operators(const State &state, Proposition *goal);
+    void mark_preferred_operators(const State &state, PropID goal_id);
 
-    void enqueue_if_necessary(Proposition *prop, int cost, UnaryOperator *op) {
+    void enqueue_if_necessary(PropID prop_id, int cost, OpID op_id) {
         assert(cost >= 0);
-        if (prop->cost == -1 || prop->cost > cost) {
-            prop->cost = cost;
-            prop->reached_by = op;
-            queue.push(cost, prop);
+        int &prop_cost_ref = prop_cost[prop_id];
+        if (prop_cost_ref == -1 || prop_cost_ref > cost) {
+            prop_cost_ref = cost;
+            prop_reached_by[prop_id] = op_id;
+            queue.push(cost, prop_id);
         }
-        assert(prop->cost != -1 && prop->cost <= cost);
+        assert(prop_cost[prop_id] != -1 && prop_cost[prop_id] <= cost);
     }
 
     void increase_cost(int &cost, int amount) {
@@ -73,9 +75,7 @@ public:
     void compute_heuristic_for_cegar(const State &state);
 
     int get_cost_for_cegar(int var, int value) const {
-        assert(utils::in_bounds(var, propositions));
-        assert(utils::in_bounds(value, propositions[var]));
-        return propositions[var][value].cost;
+        return prop_cost[get_prop_id(var, value)];
     }
 };
 }
@@ -22,20 +22,19 @@ FFHeuristic::~FFHeuristic() {
 }
 
 void FFHeuristic::mark_preferred_operators_and_relaxed_plan(
-    const State &state, Proposition *goal) {
-    if (!goal->marked) { // Only consider each subgoal once.
-        goal->marked = true;
-        UnaryOperator *unary_op = goal->reached_by;
-        if (unary_op) { // We have not yet chained back to a start node.
-            for (size_t i = 0; i < unary_op->precondition.size(); ++i)
-                mark_preferred_operators_and_relaxed_plan(
-                    state, unary_op->precondition[i]);
-            int operator_no = unary_op->operator_no;
+    const State &state, PropID goal_id) {
+    if (!prop_marked[goal_id]) { // Only consider each subgoal once.
+        prop_marked[goal_id] = true;
+        OpID op_id = prop_reached_by[goal_id];
+        if (op_id != NO_OP) { // We have not yet chained back to a start node.
+            for (PropID precond : get_preconditions(op_id))
+                mark_preferred_operators_and_relaxed_plan(state, precond);
+            int operator_no = op_operator_no[op_id];
             if (operator_no != -1) {
                 // This is not an axiom.
                 relaxed_plan[operator_no] = true;
 
-                if (unary_op->cost == unary_op->base_cost) {
+                if (op_cost[op_id] == op_base_cost[op_id]) {
                     // This test is implied by the next but cheaper,
                     // so we perform it to save work.
                     // If we had no 0-cost operators and axioms to worry
@@ -56,8 +55,8 @@ int FFHeuristic::compute_heuristic(const GlobalState &global_state) {
         return h_add;
 
     // Collecting the relaxed plan also sets the preferred operators.
-    for (size_t i = 0; i < goal_propositions.size(); ++i)
-        mark_preferred_operators_and_relaxed_plan(state, goal_propositions[i]);
+    for (PropID goal_id : goal_propositions)
+        mark_preferred_operators_and_relaxed_plan(state, goal_id);
 
     int h_ff = 0;
     for (size_t op_no = 0; op_no < relaxed_plan.size(); ++op_no) {
@@ -0,0 +1,194 @@
+#include "incremental_max_exploration.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace max_heuristic {
+const int IncrementalMaxExploration::NO_SUPPORTER;
+
+IncrementalMaxExploration::IncrementalMaxExploration(
+    const vector<int> &precondition_offsets, const vector<int> &preconditions,
+    const vector<int> &effects, const vector<int> &base_costs,
+    const vector<int> &precondition_of_offsets,
+    const vector<int> &precondition_of, bool enable_all)
+    : precondition_offsets(precondition_offsets),
+      preconditions(preconditions),
+      effects(effects),
+      base_costs(base_costs),
+      precondition_of_offsets(precondition_of_offsets),
+      precondition_of(precondition_of),
+      enabled(effects.size(), enable_all),
+      op_change_stamps(effects.size(), 0),
+      stamp(0) {
+    int num_propositions = precondition_of_offsets.size() - 1;
+    int num_ops = effects.size();
+
+    // Group the operators by effect.
+    achiever_offsets.assign(num_propositions + 1, 0);
+    for (int effect : effects)
+        ++achiever_offsets[effect + 1];
+    for (int prop = 0; prop < num_propositions; ++prop)
+        achiever_offsets[prop + 1] += achiever_offsets[prop];
+    achievers.resize(num_ops);
+    vector<int> next_achiever(achiever_offsets.begin(), achiever_offsets.end() - 1);
+    for (int op = 0; op < num_ops; ++op)
+        achievers[next_achiever[effects[op]]++] = op;
+
+    costs.assign(num_propositions, -1);
+    supporters.assign(num_propositions, NO_SUPPORTER);
+    is_initial.assign(num_propositions, false);
+    is_affected.assign(num_propositions, false);
+    unsatisfied_preconditions.reserve(num_ops);
+    for (int op = 0; op < num_ops; ++op)
+        unsatisfied_preconditions.push_back(
+            precondition_offsets[op + 1] - precondition_offsets[op]);
+}
+
+void IncrementalMaxExploration::record_change(int op) {
+    if (op_change_stamps[op] != stamp) {
+        op_change_stamps[op] = stamp;
+        changed_ops.push_back(op);
+    }
+}
+
+void IncrementalMaxExploration::mark_affected(int prop) {
+    if (!is_affected[prop]) {
+        is_affected[prop] = true;
+        affected_props.push_back(prop);
+    }
+}
+
+void IncrementalMaxExploration::set_cost(int prop, int cost, int supporter) {
+    if (costs[prop] == -1) {
+        for (int op : get_slice(precondition_of_offsets, precondition_of, prop))
+            --unsatisfied_preconditions[op];
+    }
+    costs[prop] = cost;
+    supporters[prop] = supporter;
+    queue.push(cost, prop);
+}
+
+void IncrementalMaxExploration::set_unreached(int prop) {
+    if (costs[prop] != -1) {
+        for (int op : get_slice(precondition_of_offsets, precondition_of, prop))
+            ++unsatisfied_preconditions[op];
+    }
+    costs[prop] = -1;
+    supporters[prop] = NO_SUPPORTER;
+}
+
+int IncrementalMaxExploration::get_operator_cost(int op) const {
+    assert(is_applicable(op));
+    int cost = 0;
+    for (int pre : get_slice(precondition_offsets, preconditions, op))
+        cost = max(cost, costs[pre]);
+    return base_costs[op] + cost;
+}
+
+void IncrementalMaxExploration::rederive(int prop) {
+    if (is_initial[prop]) {
+        set_cost(prop, 0, NO_SUPPORTER);
+        return;
+    }
+    int best_cost = -1;
+    int best_supporter = NO_SUPPORTER;
+    for (int op : get_slice(achiever_offsets, achievers, prop)) {
+        if (enabled[op] && is_applicable(op)) {
+            int cost = get_operator_cost(op);
+            if (best_cost == -1 || cost < best_cost) {
+                best_cost = cost;
+                best_supporter = op;
+            }
+        }
+    }
+    if (best_cost != -1)
+        set_cost(prop, best_cost, best_supporter);
+}
+
+void IncrementalMaxExploration::relax(int op) {
+    if (enabled[op] && is_applicable(op)) {
+        int cost = get_operator_cost(op);
+        int effect = effects[op];
+        if (costs[effect] == -1 || cost < costs[effect])
+            set_cost(effect, cost, op);
+    }
+}
+
+void IncrementalMaxExploration::propagate() {
+    while (!queue.empty()) {
+        pair<int, int> top_pair = queue.pop();
+        int distance = top_pair.first;
+        int prop = top_pair.second;
+        // May have decreased since we enqueued it.
+        if (costs[prop] < distance)
+            continue;
+        assert(costs[prop] == distance);
+        for (int op : get_slice(precondition_of_offsets, precondition_of, prop)) {
+            record_change(op);
+            relax(op);
+        }
+    }
+}
+
+void IncrementalMaxExploration::update(
+    const vector<int> &removed_facts, const vector<int> &added_facts,
+    const vector<int> &disabled_ops, const vector<int> &enabled_ops) {
+    ++stamp;
+    changed_ops.clear();
+    assert(queue.empty());
+    assert(affected_props.empty());
+
+    // Collect all propositions whose cost may increase.
+    for (int prop : removed_facts) {
+        assert(is_initial[prop]);
+        is_initial[prop] = false;
+        if (costs[prop] != -1 && supporters[prop] == NO_SUPPORTER)
+            mark_affected(prop);
+    }
+    for (int prop : added_facts) {
+        assert(!is_initial[prop]);
+        is_initial[prop] = true;
+    }
+    for (int op : disabled_ops) {
+        enabled[op] = false;
+        record_change(op);
+        int effect = effects[op];
+        if (supporters[effect] == op)
+            mark_affected(effect);
+    }
+    for (size_t i = 0; i < affected_props.size(); ++i) {
+        for (int op : get_slice(precondition_of_offsets, precondition_of,
+                                 affected_props[i])) {
+            record_change(op);
+            int effect = effects[op];
+            if (supporters[effect] == op)
+                mark_affected(effect);
+        }
+    }
+
+    // Re-derive affected propositions from their unaffected achievers.
+    for (int prop : affected_props)
+        set_unreached(prop);
+    for (int prop : affected_props) {
+        is_affected[prop] = false;
+        rederive(prop);
+    }
+    affected_props.clear();
+
+    // Propagate all decreases.
+    for (int prop : added_facts) {
+        if (costs[prop] != 0)
+            set_cost(prop, 0, NO_SUPPORTER);
+        else
+            supporters[prop] = NO_SUPPORTER;
+    }
+    for (int op : enabled_ops) {
+        enabled[op] = true;
+        record_change(op);
+        relax(op);
+    }
+    propagate();
+}
+}
@@ -0,0 +1,117 @@
+#ifndef HEURISTICS_INCREMENTAL_MAX_EXPLORATION_H
+#define HEURISTICS_INCREMENTAL_MAX_EXPLORATION_H
+
+#include "relaxation_heuristic.h"
+
+#include "../algorithms/priority_queues.h"
+
+#include <vector>
+
+namespace max_heuristic {
+/*
+  h^max exploration for one cost function of a relaxed task that can be
+  repaired after facts have been added to or removed from the state and
+  unary operators have been enabled or disabled, instead of being
+  recomputed from scratch.
+
+  Every reached proposition remembers the unary operator that achieves its
+  cost (its supporter; initial facts have none). Changes that can increase
+  costs invalidate all propositions whose supporters depend on a changed
+  proposition or operator. These are re-derived from their remaining
+  achievers, and all cost decreases are then propagated with a
+  Dijkstra-style exploration. Unlike the regular h^max computation, the
+  exploration always runs to a fixpoint, since later updates rely on the
+  costs of all propositions.
+
+  Propositions and unary operators are identified by their PropIDs and
+  OpIDs in the relaxation heuristic.
+*/
+class IncrementalMaxExploration {
+    static const int NO_SUPPORTER = -1;
+
+    // Relaxed task; index lists are stored as in RelaxationHeuristic.
+    const std::vector<int> &precondition_offsets;
+    const std::vector<int> &preconditions;
+    const std::vector<int> &effects;
+    const std::vector<int> &base_costs;
+    const std::vector<int> &precondition_of_offsets;
+    const std::vector<int> &precondition_of;
+    std::vector<int> achiever_offsets;
+    std::vector<int> achievers;
+
+    std::vector<int> costs; // -1 for unreached propositions
+    std::vector<int> supporters;
+    std::vector<bool> is_initial;
+    std::vector<int> unsatisfied_preconditions;
+    std::vector<bool> enabled;
+
+    priority_queues::AdaptiveQueue<int> queue;
+    std::vector<bool> is_affected;
+    std::vector<int> affected_props;
+
+    // Operators whose cost or applicability may have changed.
+    std::vector<int> changed_ops;
+    std::vector<int> op_change_stamps;
+    int stamp;
+
+    void record_change(int op);
+    void mark_affected(int prop);
+    void set_cost(int prop, int cost, int supporter);
+    void set_unreached(int prop);
+    void rederive(int prop);
+    void relax(int op);
+    void propagate();
+
+    relaxation_heuristic::IDSlice get_slice(
+        const std::vector<int> &offsets, const std::vector<int> &ids,
+        int index) const {
+        return relaxation_heuristic::IDSlice(
+            ids.data() + offsets[index], ids.data() + offsets[index + 1]);
+    }
+public:
+    /*
+      The exploration refers to (and does not copy) the given arrays of the
+      relaxed task, which must outlive it.
+    */
+    IncrementalMaxExploration(
+        const std::vector<int> &precondition_offsets,
+        const std::vector<int> &preconditions,
+        const std::vector<int> &effects,
+        const std::vector<int> &base_costs,
+        const std::vector<int> &precondition_of_offsets,
+        const std::vector<int> &precondition_of,
+        bool enable_all);
+
+    /*
+      Facts in removed_facts (added_facts) must have been (must not have
+      been) initial facts so far. Enabled operators are explored if they
+      are applicable, even if they have been enabled before.
+    */
+    void update(const std::vector<int> &removed_facts,
+                const std::vector<int> &added_facts,
+                const std::vector<int> &disabled_ops,
+                const std::vector<int> &enabled_ops);
+
+    int get_cost(int prop) const {
+        return costs[prop];
+    }
+
+    bool is_applicable(int op) const {
+        return unsatisfied_preconditions[op] == 0;
+    }
+
+    bool is_enabled(int op) const {
+        return enabled[op];
+    }
+
+    // Must only be called for applicable operators.
+    int get_operator_cost(int op) const;
+
+    // Operators whose cost or applicability may have changed in the last update.
+    const std::vector<int> &get_changed_operators() const {
+        return changed_ops;
+    }
+};
+}
+
+#endif
@@ -4,6 +4,9 @@
 #include "../option_parser.h"
 #include "../plugin.h"
 
+#include "../utils/memory.h"
+
+#include <algorithm>
 #include <cassert>
 #include <limits>
 #include <vector>
@@ -24,9 +27,21 @@ namespace max_heuristic {
 
 // construction and destruction
 HSPMaxHeuristic::HSPMaxHeuristic(const Options &opts)
-  : RelaxationHeuristic(opts), use_cost_bound(opts.get<bool>("use_cost_bound")) {
+  : RelaxationHeuristic(opts), use_cost_bound(opts.get<bool>("use_cost_bound")),
+    incremental(opts.get<bool>("incremental")),
+    previous_cost_bound(-1) {
     cout << "Initializing HSP max heuristic..." << endl;
     cout << "use_cost_bound = " << (use_cost_bound ? "true" : "false") << endl;
+    if (incremental) {
+        bounded_exploration = utils::make_unique_ptr<IncrementalMaxExploration>(
+            op_precondition_offsets, op_preconditions, op_effect,
+            op_base_bounded_cost, prop_precondition_of_offsets,
+            prop_precondition_of, true);
+        cost_exploration = utils::make_unique_ptr<IncrementalMaxExploration>(
+            op_precondition_offsets, op_preconditions, op_effect,
+            op_base_cost, prop_precondition_of_offsets,
+            prop_precondition_of, false);
+    }
 }
 
 HSPMaxHeuristic::~HSPMaxHeuristic() {
@@ -34,32 +49,27 @@ HSPMaxHeuristic::~HSPMaxHeuristic() {
 
 // heuristic computation
 void HSPMaxHeuristic::setup_exploration_queue(int bound) {
-  // queue.clear();
-  while (!queue.empty()) queue.pop();
+    queue.clear();
 
-    for (vector<Proposition> &props_of_var : propositions) {
-        for (Proposition &prop : props_of_var) {
-            prop.cost = -1;
-	    prop.bounded_cost = -1;
-        }
-    }
+    reset_proposition_costs();
+    fill(prop_bounded_cost.begin(), prop_bounded_cost.end(), -1);
 
     // Deal with operators and axioms without preconditions.
-    for (UnaryOperator &op : unary_operators) {
-        op.unsatisfied_preconditions = op.precondition.size();
-        op.cost = op.base_cost; // will be increased by precondition costs
-	op.bounded_cost = op.base_bounded_cost;
-
-        if (op.unsatisfied_preconditions == 0 &&
-	    (!use_cost_bound || op.bounded_cost <= bound)) {
-            enqueue_if_necessary(op.effect, op.cost, op.bounded_cost);
-	}
+    reset_unary_operators();
+    copy(op_base_bounded_cost.begin(), op_base_bounded_cost.end(),
+         op_bounded_cost.begin());
+    for (OpID op_id = 0; op_id < num_unary_operators; ++op_id) {
+        if (op_unsatisfied_preconditions[op_id] == 0 &&
+            (!use_cost_bound || op_bounded_cost[op_id] <= bound)) {
+            enqueue_if_necessary(op_effect[op_id], op_cost[op_id],
+                                 op_bounded_cost[op_id]);
+        }
     }
 }
 
 void HSPMaxHeuristic::setup_exploration_queue_state(const State &state) {
     for (FactProxy fact : state) {
-        Proposition *init_prop = get_proposition(fact);
+        PropID init_prop = get_prop_id(fact);
         enqueue_if_necessary(init_prop, 0, 0);
     }
 }
@@ -67,60 +77,39 @@ void HSPMaxHeuristic::setup_exploration_queue_state(const State &state) {
 void HSPMaxHeuristic::relaxed_exploration(int cost_bound) {
     int unsolved_goals = goal_propositions.size();
     while (!queue.empty()) {
-      
-      // pair<int, Proposition *> top_pair = queue.pop();
-      // int distance = top_pair.first;
-      // Proposition *prop = top_pair.second;
-
-      PQEntry pq_entry = queue.top(); 
-      queue.pop();
-
-      int distance = pq_entry.costs.first;
-      int bounded_distance = pq_entry.costs.second;
-      Proposition *prop = pq_entry.prop;
-
-        int prop_cost = prop->cost;
-	int prop_bounded_cost = prop->bounded_cost;
-
-	// May have decreased since we enqueued it.
-        assert(prop_cost <= distance);
-
-//  	cout << prop_names_dict[prop->id]
-//  	     << " with cost " << prop_cost << ", bounded cost " << prop_bounded_cost << endl;
-
-// 	if (use_cost_bound && prop_bounded_cost > cost_bound) {
-// 	  continue;
-// 	}
-
-        if (prop_cost < distance || (prop_cost == distance && prop_bounded_cost < bounded_distance)) {
+        pair<pair<int, int>, PropID> top_pair = queue.pop();
+        int distance = top_pair.first.first;
+        int bounded_distance = top_pair.first.second;
+        PropID prop_id = top_pair.second;
+
+        int cost = prop_cost[prop_id];
+        int bounded_cost = prop_bounded_cost[prop_id];
+
+        // May have decreased since we enqueued it.
+        assert(cost <= distance);
+        if (cost < distance ||
+            (cost == distance && bounded_cost < bounded_distance)) {
             continue;
-	}
-        if (prop->is_goal && --unsolved_goals == 0) {
+        }
+        if (prop_is_goal[prop_id] && --unsolved_goals == 0) {
             return;
-	}
-        const vector<UnaryOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (UnaryOperator *unary_op : triggered_operators) {
-	    unary_op->bounded_cost = max(unary_op->bounded_cost, 
-					 unary_op->base_bounded_cost + prop_bounded_cost);
-
-	    if (use_cost_bound && unary_op->bounded_cost > cost_bound) {
-	      break;
-	    }
-
-            --unary_op->unsatisfied_preconditions;
-            unary_op->cost = max(unary_op->cost,
-                                 unary_op->base_cost + prop_cost);
-
-// 	    cout << "Unary op " << task_proxy.get_operators()[unary_op->operator_no].get_name()
-// 		 << " has " << unary_op->unsatisfied_preconditions << " preconditions remaining "
-// 		 << "(cost: " << unary_op->cost << ", bounded cost: "
-// 		 << unary_op->bounded_cost << ")" << endl;
-
-            assert(unary_op->unsatisfied_preconditions >= 0);
-            if (unary_op->unsatisfied_preconditions == 0) {
-	      enqueue_if_necessary(unary_op->effect, unary_op->cost, unary_op->bounded_cost);
-	    }
+        }
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            op_bounded_cost[op_id] = max(op_bounded_cost[op_id],
+                                         op_base_bounded_cost[op_id] + bounded_cost);
+
+            if (use_cost_bound && op_bounded_cost[op_id] > cost_bound) {
+                break;
+            }
+
+            --op_unsatisfied_preconditions[op_id];
+            op_cost[op_id] = max(op_cost[op_id], op_base_cost[op_id] + cost);
+
+            assert(op_unsatisfied_preconditions[op_id] >= 0);
+            if (op_unsatisfied_preconditions[op_id] == 0) {
+                enqueue_if_necessary(op_effect[op_id], op_cost[op_id],
+                                     op_bounded_cost[op_id]);
+            }
         }
     }
 }
@@ -134,12 +123,77 @@ int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state) {
   return compute_heuristic(global_state, std::numeric_limits<int>::max());
 }
 
+int HSPMaxHeuristic::compute_heuristic_incrementally(
+    const State &state, int cost_bound) {
+    if (!use_cost_bound)
+        cost_bound = numeric_limits<int>::max();
+
+    vector<int> removed_facts;
+    vector<int> added_facts;
+    const vector<int> &state_values = state.get_values();
+    bool first_evaluation = previous_state_values.empty();
+    for (size_t var = 0; var < state_values.size(); ++var) {
+        int value = state_values[var];
+        if (first_evaluation) {
+            added_facts.push_back(get_prop_id(var, value));
+        } else if (previous_state_values[var] != value) {
+            removed_facts.push_back(
+                get_prop_id(var, previous_state_values[var]));
+            added_facts.push_back(get_prop_id(var, value));
+        }
+    }
+    previous_state_values = state_values;
+
+    vector<int> candidate_ops;
+    if (first_evaluation) {
+        candidate_ops.resize(num_unary_operators);
+        for (OpID op_id = 0; op_id < num_unary_operators; ++op_id)
+            candidate_ops[op_id] = op_id;
+        bounded_exploration->update({}, added_facts, {}, candidate_ops);
+    } else {
+        bounded_exploration->update(removed_facts, added_facts, {}, {});
+        if (cost_bound == previous_cost_bound) {
+            candidate_ops = bounded_exploration->get_changed_operators();
+        } else {
+            candidate_ops.resize(num_unary_operators);
+            for (OpID op_id = 0; op_id < num_unary_operators; ++op_id)
+                candidate_ops[op_id] = op_id;
+        }
+    }
+    previous_cost_bound = cost_bound;
+
+    // Enable exactly the operators that are applicable within the bound.
+    vector<int> disabled_ops;
+    vector<int> enabled_ops;
+    for (int op : candidate_ops) {
+        bool within_bound =
+            bounded_exploration->is_applicable(op) &&
+            bounded_exploration->get_operator_cost(op) <= cost_bound;
+        if (within_bound && !cost_exploration->is_enabled(op))
+            enabled_ops.push_back(op);
+        else if (!within_bound && cost_exploration->is_enabled(op))
+            disabled_ops.push_back(op);
+    }
+    cost_exploration->update(removed_facts, added_facts, disabled_ops, enabled_ops);
+
+    int total_cost = 0;
+    for (PropID goal_id : goal_propositions) {
+        int goal_cost = cost_exploration->get_cost(goal_id);
+        if (goal_cost == -1)
+            return DEAD_END;
+        total_cost = max(total_cost, goal_cost);
+    }
+    return total_cost;
+}
+
 int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state, int cost_bound) {
 //   static int h_eval_count = 0;
 //   cout << "Evaluating state with cost bound " << cost_bound << "(" << h_eval_count++ << " evals done so far)" << endl;
 //   global_state.dump_pddl();
 
     const State state = convert_global_state(global_state);
+    if (incremental)
+        return compute_heuristic_incrementally(state, cost_bound);
 
     int total_cost = 0;
 
@@ -148,28 +202,17 @@ int HSPMaxHeuristic::compute_heuristic(const GlobalState &global_state, int cost
     relaxed_exploration(cost_bound);
     
     total_cost = 0;
-    for (Proposition *prop : goal_propositions) {
-      int prop_cost = prop->cost;
-      if (prop_cost == -1) {
+    for (PropID goal_id : goal_propositions) {
+      int goal_cost = prop_cost[goal_id];
+      if (goal_cost == -1) {
 	return DEAD_END;
       }
-      total_cost = max(total_cost, prop_cost);
+      total_cost = max(total_cost, goal_cost);
     }
 
     //    cout << "Returning total_cost = " << total_cost << endl << endl;
     return total_cost;
 }
-  
-  void HSPMaxHeuristic::notify_state_transition(
-    const GlobalState &parent_state, OperatorID op_id,
-    const GlobalState &state) {
-    (void) parent_state;
-    (void) op_id;
-    (void) state;
-    if (cache_evaluator_values && use_cost_bound) {
-      heuristic_cache[state].dirty = true;
-    }
-  }
 
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_synopsis("Max heuristic", "");
@@ -187,6 +230,11 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
 
     parser.add_option<bool>("use_cost_bound",
 			    "Use or ignore passed in secondary cost bound", "true");
+    parser.add_option<bool>(
+        "incremental",
+        "repair the relaxed exploration of the previously evaluated state "
+        "instead of recomputing it from scratch",
+        "false");
 
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
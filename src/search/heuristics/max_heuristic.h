@@ -1,77 +1,74 @@
 #ifndef HEURISTICS_MAX_HEURISTIC_H
 #define HEURISTICS_MAX_HEURISTIC_H
 
+#include "incremental_max_exploration.h"
 #include "relaxation_heuristic.h"
 
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
-#include <queue>
+#include <memory>
+#include <vector>
 
 namespace max_heuristic {
-using relaxation_heuristic::Proposition;
-using relaxation_heuristic::UnaryOperator;
+using relaxation_heuristic::PropID;
+using relaxation_heuristic::OpID;
 
 class HSPMaxHeuristic : public relaxation_heuristic::RelaxationHeuristic {
-  // priority_queues::AdaptiveQueue<Proposition *> queue;
-
-  struct PQEntry {
-    std::pair<int, int> costs;
-    Proposition* prop;
-
-    bool operator> (const PQEntry& other) const {
-      if (costs.first > other.costs.first) return true;
-      if (costs.first == other.costs.first && costs.second > other.costs.second) return true;
-      return false;
-    };
-    
-    PQEntry(const std::pair<int,int>& costs, Proposition* prop) : 
-      costs(costs), prop(prop) {}
-  };
-  
-  std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> queue;
+    // Ordered lexicographically by (cost, bounded_cost).
+    priority_queues::PairBucketQueue<PropID> queue;
 
     void setup_exploration_queue(int bound);
     void setup_exploration_queue_state(const State &state);
     void relaxed_exploration(int bound);
 
-    void enqueue_if_necessary(Proposition *prop, int cost, int bounded_cost) {
+    void enqueue_if_necessary(PropID prop_id, int cost, int bounded_cost) {
         assert(cost >= 0);
-	bool enqueue = false;
-        if (prop->cost == -1 || prop->cost > cost) {
-            prop->cost = cost;
-	    enqueue = true;
+        bool enqueue = false;
+        if (prop_cost[prop_id] == -1 || prop_cost[prop_id] > cost) {
+            prop_cost[prop_id] = cost;
+            enqueue = true;
+        }
+        if (prop_bounded_cost[prop_id] == -1 ||
+            prop_bounded_cost[prop_id] > bounded_cost) {
+            prop_bounded_cost[prop_id] = bounded_cost;
+            enqueue = true;
         }
-	if (prop->bounded_cost == -1 || prop->bounded_cost > bounded_cost) {
-	  prop->bounded_cost = bounded_cost;
-	  enqueue = true;
-	}
-	if (enqueue) {
-	  queue.push(PQEntry(std::make_pair(prop->cost, prop->bounded_cost), prop));
-	}
-        assert(prop->cost != -1 && prop->cost <= cost);
+        if (enqueue) {
+            queue.push(prop_cost[prop_id], prop_bounded_cost[prop_id], prop_id);
+        }
+        assert(prop_cost[prop_id] != -1 && prop_cost[prop_id] <= cost);
     }
 
     bool use_cost_bound;
 
+    /*
+      In incremental mode, the exploration of the last evaluated state is
+      repaired instead of recomputed. The bounded costs are explored without
+      the cost bound (facts within the bound have the same bounded cost
+      either way), and the primary costs only through operators whose
+      bounded cost is within the bound.
+    */
+    const bool incremental;
+    std::unique_ptr<IncrementalMaxExploration> bounded_exploration;
+    std::unique_ptr<IncrementalMaxExploration> cost_exploration;
+    std::vector<int> previous_state_values;
+    int previous_cost_bound;
+
+    int compute_heuristic_incrementally(const State &state, int cost_bound);
+
 protected:
     int compute_heuristic(const GlobalState &global_state, int cost_bound);
     virtual int compute_heuristic(const GlobalState &global_state) override;
     virtual int compute_heuristic_w_bound(
 	const GlobalState &global_state, int cost_bound) override;
 public:
-    
-    virtual void notify_state_transition(const GlobalState &parent_state,
-                                         OperatorID op_id,
-                                         const GlobalState &state) override;
-
-    virtual void get_path_dependent_evaluators(
-        std::set<Evaluator *> &evals) override {
-        evals.insert(this);
-    }
-
     HSPMaxHeuristic(const options::Options &opts);
     ~HSPMaxHeuristic();
+
+    virtual bool depends_on_cost_bound() const override {
+        return use_cost_bound;
+    }
 };
 }
 
@@ -13,87 +13,48 @@
 using namespace std;
 
 namespace relaxation_heuristic {
-// construction and destruction
-RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
-    : Heuristic(opts) {
-    // Build propositions.
-    int prop_id = 0;
-    VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-      prop_names_dict[prop_id] = fact.get_name();
-        propositions[fact.get_variable().get_id()].push_back(Proposition(prop_id++));
-    }
-
-    // Build goal propositions.
-    for (FactProxy goal : task_proxy.get_goals()) {
-        Proposition *prop = get_proposition(goal);
-        prop->is_goal = true;
-        goal_propositions.push_back(prop);
-    }
-
-    // Build unary operators for operators and axioms.
-    int op_no = 0;
-    for (OperatorProxy op : task_proxy.get_operators())
-        build_unary_operators(op, op_no++);
-    for (OperatorProxy axiom : task_proxy.get_axioms())
-        build_unary_operators(axiom, -1);
-
-    // Simplify unary operators.
-    simplify();
-
-    // Cross-reference unary operators.
-    for (size_t i = 0; i < unary_operators.size(); ++i) {
-        UnaryOperator *op = &unary_operators[i];
-        for (size_t j = 0; j < op->precondition.size(); ++j)
-            op->precondition[j]->precondition_of.push_back(op);
-    }
-
-    for (std::vector<Proposition>& var_propositions : propositions) {
-      for (Proposition& fact_prop : var_propositions) {
-	std::sort(fact_prop.precondition_of.begin(), 
-		  fact_prop.precondition_of.end(),
-		  [](const UnaryOperator* op1, const UnaryOperator* op2) {
-		    return op1->base_bounded_cost < op2->base_bounded_cost;
-		  });
-      }
-    }
-}
-
-RelaxationHeuristic::~RelaxationHeuristic() {
-}
-
-bool RelaxationHeuristic::dead_ends_are_reliable() const {
-    return !task_properties::has_axioms(task_proxy);
+namespace {
+// Unary operator representation used while building the relaxed task.
+struct UnaryOperator {
+    int operator_no;
+    vector<PropID> precondition;
+    PropID effect;
+    int base_cost;
+    int base_bounded_cost;
+    UnaryOperator(const vector<PropID> &pre, PropID eff,
+                  int operator_no_, int base, int base_bounded)
+        : operator_no(operator_no_), precondition(pre), effect(eff),
+          base_cost(base), base_bounded_cost(base_bounded) {}
+};
+
+PropID get_prop_id(const vector<PropID> &proposition_offsets,
+                   const FactProxy &fact) {
+    return proposition_offsets[fact.get_variable().get_id()] + fact.get_value();
 }
 
-Proposition *RelaxationHeuristic::get_proposition(const FactProxy &fact) {
-    int var = fact.get_variable().get_id();
-    int value = fact.get_value();
-    assert(utils::in_bounds(var, propositions));
-    assert(utils::in_bounds(value, propositions[var]));
-    return &propositions[var][value];
-}
-
-void RelaxationHeuristic::build_unary_operators(const OperatorProxy &op, int op_no) {
+void build_unary_operators(
+    const OperatorProxy &op, int op_no,
+    const vector<PropID> &proposition_offsets,
+    vector<UnaryOperator> &unary_operators) {
     int base_cost = op.get_cost();
-    vector<Proposition *> precondition_props;
+    int base_bounded_cost = op.get_bounded_cost();
+    vector<PropID> precondition_props;
     for (FactProxy precondition : op.get_preconditions()) {
-        precondition_props.push_back(get_proposition(precondition));
+        precondition_props.push_back(get_prop_id(proposition_offsets, precondition));
     }
     for (EffectProxy effect : op.get_effects()) {
-        Proposition *effect_prop = get_proposition(effect.get_fact());
+        PropID effect_prop = get_prop_id(proposition_offsets, effect.get_fact());
         EffectConditionsProxy eff_conds = effect.get_conditions();
         for (FactProxy eff_cond : eff_conds) {
-            precondition_props.push_back(get_proposition(eff_cond));
+            precondition_props.push_back(get_prop_id(proposition_offsets, eff_cond));
         }
         unary_operators.push_back(UnaryOperator(precondition_props, effect_prop, op_no,
-						base_cost, op.get_bounded_cost()));
+                                                base_cost, base_bounded_cost));
         precondition_props.erase(precondition_props.end() - eff_conds.size(), precondition_props.end());
     }
 }
 
-void RelaxationHeuristic::simplify() {
+void simplify(vector<UnaryOperator> &unary_operators) {
     // Remove duplicate or dominated unary operators.
 
     /*
@@ -109,13 +70,13 @@ void RelaxationHeuristic::simplify() {
       never dominates a lower-cost operator.
 
       In the end, the vector of unary operators is sorted by operator_no,
-      effect->id, base_cost and precondition.
+      effect, base_cost and precondition.
     */
 
 
     cout << "Simplifying " << unary_operators.size() << " unary operators..." << flush;
 
-    using Key = pair<vector<Proposition *>, Proposition *>;
+    using Key = pair<vector<PropID>, PropID>;
     using Map = utils::HashMap<Key, int>;
     Map unary_operator_index;
     unary_operator_index.reserve(unary_operators.size());
@@ -123,10 +84,7 @@ void RelaxationHeuristic::simplify() {
 
     for (size_t i = 0; i < unary_operators.size(); ++i) {
         UnaryOperator &op = unary_operators[i];
-        sort(op.precondition.begin(), op.precondition.end(),
-             [] (const Proposition *p1, const Proposition *p2) {
-                 return p1->id < p2->id;
-             });
+        sort(op.precondition.begin(), op.precondition.end());
         Key key(op.precondition, op.effect);
         pair<Map::iterator, bool> inserted = unary_operator_index.insert(
             make_pair(key, i));
@@ -135,16 +93,14 @@ void RelaxationHeuristic::simplify() {
             Map::iterator iter = inserted.first;
             int old_op_no = iter->second;
             int old_cost = unary_operators[old_op_no].base_cost;
-	    int old_bounded_cost = unary_operators[old_op_no].base_bounded_cost;
+            int old_bounded_cost = unary_operators[old_op_no].base_bounded_cost;
 
             int new_cost = unary_operators[i].base_cost;
-	    int new_bounded_cost = unary_operators[i].base_bounded_cost;
+            int new_bounded_cost = unary_operators[i].base_bounded_cost;
 
             if (new_cost <= old_cost && new_bounded_cost <= old_bounded_cost) {
                 iter->second = i;
-	    }
-            assert(unary_operators[unary_operator_index[key]].base_cost ==
-                   min(old_cost, new_cost));
+            }
         }
     }
 
@@ -159,7 +115,7 @@ void RelaxationHeuristic::simplify() {
         if (key.first.size() <= 5) { // HACK! Don't spend too much time here...
             int powerset_size = (1 << key.first.size()) - 1; // -1: only consider proper subsets
             for (int mask = 0; mask < powerset_size; ++mask) {
-                Key dominating_key = make_pair(vector<Proposition *>(), key.second);
+                Key dominating_key = make_pair(vector<PropID>(), key.second);
                 for (size_t i = 0; i < key.first.size(); ++i)
                     if (mask & (1 << i))
                         dominating_key.first.push_back(key.first[i]);
@@ -167,7 +123,7 @@ void RelaxationHeuristic::simplify() {
                     dominating_key);
                 if (found != unary_operator_index.end()) {
                     int my_cost = old_unary_operators[unary_operator_no].base_cost;
-		    int my_bounded_cost = old_unary_operators[unary_operator_no].base_bounded_cost;
+                    int my_bounded_cost = old_unary_operators[unary_operator_no].base_bounded_cost;
                     int dominator_op_no = found->second;
                     int dominator_cost = old_unary_operators[dominator_op_no].base_cost;
                     int dominator_bounded_cost = old_unary_operators[dominator_op_no].base_bounded_cost;
@@ -187,16 +143,107 @@ void RelaxationHeuristic::simplify() {
              if (o1.operator_no != o2.operator_no)
                  return o1.operator_no < o2.operator_no;
              if (o1.effect != o2.effect)
-                 return o1.effect->id < o2.effect->id;
+                 return o1.effect < o2.effect;
              if (o1.base_cost != o2.base_cost)
                  return o1.base_cost < o2.base_cost;
              return lexicographical_compare(o1.precondition.begin(), o1.precondition.end(),
-                                            o2.precondition.begin(), o2.precondition.end(),
-                                            [] (const Proposition *p1, const Proposition *p2) {
-                                                return p1->id < p2->id;
-                                            });
+                                            o2.precondition.begin(), o2.precondition.end());
          });
 
     cout << " done! [" << unary_operators.size() << " unary operators]" << endl;
 }
 }
+
+// construction and destruction
+RelaxationHeuristic::RelaxationHeuristic(const options::Options &opts)
+    : Heuristic(opts) {
+    // Build propositions.
+    num_propositions = 0;
+    VariablesProxy variables = task_proxy.get_variables();
+    proposition_offsets.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        proposition_offsets.push_back(num_propositions);
+        num_propositions += var.get_domain_size();
+    }
+
+    // Build goal propositions.
+    prop_is_goal.resize(num_propositions, false);
+    for (FactProxy goal : task_proxy.get_goals()) {
+        PropID prop_id = get_prop_id(goal);
+        prop_is_goal[prop_id] = true;
+        goal_propositions.push_back(prop_id);
+    }
+
+    // Build unary operators for operators and axioms.
+    vector<UnaryOperator> unary_operators;
+    int op_no = 0;
+    for (OperatorProxy op : task_proxy.get_operators())
+        build_unary_operators(op, op_no++, proposition_offsets, unary_operators);
+    for (OperatorProxy axiom : task_proxy.get_axioms())
+        build_unary_operators(axiom, -1, proposition_offsets, unary_operators);
+
+    // Simplify unary operators.
+    simplify(unary_operators);
+
+    // Flatten unary operators.
+    num_unary_operators = unary_operators.size();
+    op_effect.reserve(num_unary_operators);
+    op_base_cost.reserve(num_unary_operators);
+    op_base_bounded_cost.reserve(num_unary_operators);
+    op_operator_no.reserve(num_unary_operators);
+    op_num_preconditions.reserve(num_unary_operators);
+    op_precondition_offsets.reserve(num_unary_operators + 1);
+    for (const UnaryOperator &op : unary_operators) {
+        op_effect.push_back(op.effect);
+        op_base_cost.push_back(op.base_cost);
+        op_base_bounded_cost.push_back(op.base_bounded_cost);
+        op_operator_no.push_back(op.operator_no);
+        op_num_preconditions.push_back(op.precondition.size());
+        op_precondition_offsets.push_back(op_preconditions.size());
+        op_preconditions.insert(op_preconditions.end(),
+                                op.precondition.begin(), op.precondition.end());
+    }
+    op_precondition_offsets.push_back(op_preconditions.size());
+
+    // Cross-reference unary operators, sorted by base bounded cost.
+    vector<vector<OpID>> precondition_of(num_propositions);
+    for (OpID op_id = 0; op_id < num_unary_operators; ++op_id) {
+        for (PropID pre : get_preconditions(op_id))
+            precondition_of[pre].push_back(op_id);
+    }
+    prop_precondition_of_offsets.reserve(num_propositions + 1);
+    prop_precondition_of.reserve(op_preconditions.size());
+    for (vector<OpID> &ops : precondition_of) {
+        sort(ops.begin(), ops.end(),
+             [this] (OpID op1, OpID op2) {
+                 return op_base_bounded_cost[op1] < op_base_bounded_cost[op2];
+             });
+        prop_precondition_of_offsets.push_back(prop_precondition_of.size());
+        prop_precondition_of.insert(prop_precondition_of.end(), ops.begin(), ops.end());
+    }
+    prop_precondition_of_offsets.push_back(prop_precondition_of.size());
+
+    op_unsatisfied_preconditions.resize(num_unary_operators);
+    op_cost.resize(num_unary_operators);
+    op_bounded_cost.resize(num_unary_operators);
+    prop_cost.resize(num_propositions, -1);
+    prop_bounded_cost.resize(num_propositions, -1);
+    prop_reached_by.resize(num_propositions, NO_OP);
+    prop_marked.resize(num_propositions, false);
+}
+
+RelaxationHeuristic::~RelaxationHeuristic() {
+}
+
+bool RelaxationHeuristic::dead_ends_are_reliable() const {
+    return !task_properties::has_axioms(task_proxy);
+}
+
+PropID RelaxationHeuristic::get_prop_id(const FactProxy &fact) const {
+    int var = fact.get_variable().get_id();
+    int value = fact.get_value();
+    assert(utils::in_bounds(var, proposition_offsets));
+    assert(value >= 0 && value < fact.get_variable().get_domain_size());
+    return get_prop_id(var, value);
+}
+}
@@ -3,69 +3,119 @@
 
 #include "../heuristic.h"
 
+#include <algorithm>
 #include <vector>
 
 class FactProxy;
 class GlobalState;
-class OperatorProxy;
 
 namespace relaxation_heuristic {
-struct Proposition;
-struct UnaryOperator;
-
-struct UnaryOperator {
-    int operator_no; // -1 for axioms; index into the task's operators otherwise
-    std::vector<Proposition *> precondition;
-    Proposition *effect;
-    int base_cost;
-    int base_bounded_cost;
-
-    int unsatisfied_preconditions;
-    int cost; // Used for h^max cost or h^add cost;
-              // includes operator cost (base_cost)
-    int bounded_cost;
-    UnaryOperator(const std::vector<Proposition *> &pre, Proposition *eff,
-                  int operator_no_, int base, int base_bounded)
-        : operator_no(operator_no_), precondition(pre), effect(eff),
-      base_cost(base), base_bounded_cost(base_bounded) {}
-};
+using PropID = int;
+using OpID = int;
+
+const OpID NO_OP = -1;
+
+/*
+  Contiguous range of IDs in one of the flat index arrays of the relaxed
+  task (preconditions of an operator, operators with a given precondition).
+*/
+class IDSlice {
+    const int *first;
+    const int *last;
+public:
+    IDSlice(const int *first, const int *last)
+        : first(first), last(last) {
+    }
+
+    const int *begin() const {
+        return first;
+    }
 
-struct Proposition {
-    bool is_goal;
-    int id;
-    std::vector<UnaryOperator *> precondition_of;
-
-    int cost; // Used for h^max cost or h^add cost
-    int bounded_cost;
-    UnaryOperator *reached_by;
-    bool marked; // used when computing preferred operators for h^add and h^FF
-
-    Proposition(int id_) {
-        id = id_;
-        is_goal = false;
-        cost = -1;
-	bounded_cost = -1;
-        reached_by = 0;
-        marked = false;
+    const int *end() const {
+        return last;
+    }
+
+    int size() const {
+        return last - first;
     }
 };
 
+/*
+  The relaxed task is stored as a structure of arrays indexed by PropID and
+  OpID. Propositions of variable var are numbered consecutively, starting at
+  proposition_offsets[var]. The precondition lists of all unary operators
+  and the inverse precondition_of lists of all propositions are each stored
+  in one contiguous array (compressed sparse row format).
+
+  The values computed by an exploration are kept in separate arrays, so
+  that each of them can be reset with a single fill or copy.
+*/
 class RelaxationHeuristic : public Heuristic {
-    void build_unary_operators(const OperatorProxy &op, int op_no);
-    void simplify();
+    std::vector<PropID> proposition_offsets;
 protected:
-    std::vector<UnaryOperator> unary_operators;
-    std::vector<std::vector<Proposition>> propositions;
-    std::vector<Proposition *> goal_propositions;
+    int num_propositions;
+    int num_unary_operators;
+
+    // Unary operators (static).
+    std::vector<PropID> op_effect;
+    std::vector<int> op_base_cost;
+    std::vector<int> op_base_bounded_cost;
+    // -1 for axioms; index into the task's operators otherwise
+    std::vector<int> op_operator_no;
+    std::vector<int> op_num_preconditions;
+    std::vector<int> op_precondition_offsets;
+    std::vector<PropID> op_preconditions;
+
+    // Propositions (static). precondition_of is sorted by base bounded cost.
+    std::vector<bool> prop_is_goal;
+    std::vector<int> prop_precondition_of_offsets;
+    std::vector<OpID> prop_precondition_of;
+    std::vector<PropID> goal_propositions;
+
+    // Unary operators (per exploration).
+    std::vector<int> op_unsatisfied_preconditions;
+    std::vector<int> op_cost; // h^max or h^add cost; includes op_base_cost
+    std::vector<int> op_bounded_cost;
+
+    // Propositions (per exploration).
+    std::vector<int> prop_cost; // h^max or h^add cost; -1 if unreached
+    std::vector<int> prop_bounded_cost;
+    std::vector<OpID> prop_reached_by;
+    std::vector<bool> prop_marked; // used for preferred operators of h^add and h^FF
+
+    PropID get_prop_id(int var, int value) const {
+        return proposition_offsets[var] + value;
+    }
+
+    PropID get_prop_id(const FactProxy &fact) const;
+
+    IDSlice get_preconditions(OpID op_id) const {
+        const int *data = op_preconditions.data();
+        return IDSlice(data + op_precondition_offsets[op_id],
+                       data + op_precondition_offsets[op_id + 1]);
+    }
+
+    IDSlice get_precondition_of(PropID prop_id) const {
+        const int *data = prop_precondition_of.data();
+        return IDSlice(data + prop_precondition_of_offsets[prop_id],
+                       data + prop_precondition_of_offsets[prop_id + 1]);
+    }
+
+    void reset_unary_operators() {
+        std::copy(op_num_preconditions.begin(), op_num_preconditions.end(),
+                  op_unsatisfied_preconditions.begin());
+        std::copy(op_base_cost.begin(), op_base_cost.end(), op_cost.begin());
+    }
+
+    void reset_proposition_costs() {
+        std::fill(prop_cost.begin(), prop_cost.end(), -1);
+    }
 
-    Proposition *get_proposition(const FactProxy &fact);
     virtual int compute_heuristic(const GlobalState &state) = 0;
 public:
     RelaxationHeuristic(const options::Options &opts);
     virtual ~RelaxationHeuristic();
     virtual bool dead_ends_are_reliable() const;
-
-    map<int, string> prop_names_dict;
 };
 }
 
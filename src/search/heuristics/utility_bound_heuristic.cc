@@ -0,0 +1,121 @@
+#include "utility_bound_heuristic.h"
+
+#include "../global_state.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace utility_bound_heuristic {
+UtilityBoundHeuristic::UtilityBoundHeuristic(const Options &opts)
+    : RelaxationHeuristic(opts),
+      max_possible_utility(task_proxy.get_max_possible_utility()) {
+    cout << "Initializing utility bound heuristic..." << endl;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        UtilityVariable utility_var;
+        utility_var.var = var.get_id();
+        bool has_utility = false;
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            int utility = task_proxy.get_fact_utility(FactPair(var.get_id(), value));
+            utility_var.value_utilities.push_back(utility);
+            if (utility != 0)
+                has_utility = true;
+        }
+        if (has_utility)
+            utility_variables.push_back(move(utility_var));
+    }
+    cout << "Variables with utilities: " << utility_variables.size() << endl;
+}
+
+void UtilityBoundHeuristic::relaxed_exploration(
+    const State &state, int cost_bound) {
+    queue.clear();
+    fill(prop_bounded_cost.begin(), prop_bounded_cost.end(), -1);
+
+    copy(op_num_preconditions.begin(), op_num_preconditions.end(),
+         op_unsatisfied_preconditions.begin());
+    copy(op_base_bounded_cost.begin(), op_base_bounded_cost.end(),
+         op_bounded_cost.begin());
+    for (OpID op_id = 0; op_id < num_unary_operators; ++op_id) {
+        if (op_unsatisfied_preconditions[op_id] == 0 &&
+            op_bounded_cost[op_id] <= cost_bound)
+            enqueue_if_necessary(op_effect[op_id], op_bounded_cost[op_id]);
+    }
+
+    for (FactProxy fact : state) {
+        enqueue_if_necessary(get_prop_id(fact), 0);
+    }
+
+    while (!queue.empty()) {
+        pair<int, PropID> top_pair = queue.pop();
+        int distance = top_pair.first;
+        PropID prop_id = top_pair.second;
+        int prop_cost = prop_bounded_cost[prop_id];
+        assert(prop_cost <= distance);
+        if (prop_cost < distance)
+            continue;
+        // precondition_of is sorted by base bounded cost.
+        for (OpID op_id : get_precondition_of(prop_id)) {
+            if (op_base_bounded_cost[op_id] + prop_cost > cost_bound)
+                break;
+            op_bounded_cost[op_id] = max(op_bounded_cost[op_id],
+                                         op_base_bounded_cost[op_id] + prop_cost);
+            --op_unsatisfied_preconditions[op_id];
+            assert(op_unsatisfied_preconditions[op_id] >= 0);
+            if (op_unsatisfied_preconditions[op_id] == 0)
+                enqueue_if_necessary(op_effect[op_id], op_bounded_cost[op_id]);
+        }
+    }
+}
+
+int UtilityBoundHeuristic::compute_heuristic(const GlobalState &global_state) {
+    return compute_heuristic_w_bound(global_state, numeric_limits<int>::max());
+}
+
+int UtilityBoundHeuristic::compute_heuristic_w_bound(
+    const GlobalState &global_state, int cost_bound) {
+    const State state = convert_global_state(global_state);
+    relaxed_exploration(state, cost_bound);
+
+    int utility_bound = 0;
+    for (const UtilityVariable &utility_var : utility_variables) {
+        int best = 0;
+        for (size_t value = 0; value < utility_var.value_utilities.size(); ++value) {
+            if (prop_bounded_cost[get_prop_id(utility_var.var, value)] != -1)
+                best = max(best, utility_var.value_utilities[value]);
+        }
+        utility_bound += best;
+    }
+    assert(utility_bound <= max_possible_utility);
+    return max_possible_utility - utility_bound;
+}
+
+static shared_ptr<Heuristic> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Utility bound heuristic",
+        "Maximal possible utility minus an upper bound on the utility that "
+        "is reachable from the state within the remaining secondary cost "
+        "bound, computed by an h^max exploration over the bounded operator "
+        "costs. Intended as the utility_bound of eager search in anytime "
+        "mode, where it prunes states that cannot improve on the incumbent.");
+    parser.document_language_support("action costs", "supported");
+    parser.document_language_support("conditional effects", "supported");
+    parser.document_language_support("axioms", "not supported");
+    parser.document_property("admissible", "no (bounds plan cost, not cost-to-go)");
+    parser.document_property("consistent", "no");
+    parser.document_property("safe", "yes for tasks without axioms");
+    parser.document_property("preferred operators", "no");
+
+    Heuristic::add_options_to_parser(parser);
+    Options opts = parser.parse();
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<UtilityBoundHeuristic>(opts);
+}
+
+static Plugin<Evaluator> _plugin("osp_utility_bound", _parse);
+}
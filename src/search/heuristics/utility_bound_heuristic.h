@@ -0,0 +1,58 @@
+#ifndef HEURISTICS_UTILITY_BOUND_HEURISTIC_H
+#define HEURISTICS_UTILITY_BOUND_HEURISTIC_H
+
+#include "relaxation_heuristic.h"
+
+#include "../algorithms/priority_queues.h"
+
+#include <cassert>
+#include <vector>
+
+namespace utility_bound_heuristic {
+using relaxation_heuristic::PropID;
+using relaxation_heuristic::OpID;
+
+/*
+  Upper bound on the utility achievable from a state within the remaining
+  secondary cost bound. A fact is reachable if its h^max value with respect
+  to the bounded operator costs does not exceed the remaining bound; the
+  utility of a variable is at most the best utility of any of its reachable
+  values. The heuristic value is get_max_possible_utility() minus this upper
+  bound, i.e., a lower bound on the cost of any plan through the state in
+  the OSP compilations (independently of the g value of the state).
+*/
+class UtilityBoundHeuristic : public relaxation_heuristic::RelaxationHeuristic {
+    struct UtilityVariable {
+        int var;
+        std::vector<int> value_utilities;
+    };
+    std::vector<UtilityVariable> utility_variables;
+    int max_possible_utility;
+
+    priority_queues::AdaptiveQueue<PropID> queue;
+
+    void enqueue_if_necessary(PropID prop_id, int bounded_cost) {
+        assert(bounded_cost >= 0);
+        if (prop_bounded_cost[prop_id] == -1 ||
+            prop_bounded_cost[prop_id] > bounded_cost) {
+            prop_bounded_cost[prop_id] = bounded_cost;
+            queue.push(bounded_cost, prop_id);
+        }
+    }
+
+    void relaxed_exploration(const State &state, int cost_bound);
+
+protected:
+    virtual int compute_heuristic(const GlobalState &global_state) override;
+    virtual int compute_heuristic_w_bound(
+        const GlobalState &global_state, int cost_bound) override;
+public:
+    explicit UtilityBoundHeuristic(const options::Options &opts);
+
+    virtual bool depends_on_cost_bound() const override {
+        return true;
+    }
+};
+}
+
+#endif
@@ -5,20 +5,201 @@
 
 #include "../algorithms/priority_queues.h"
 
+#include "../utils/collections.h"
+#include "../utils/parallel.h"
+
+#include <algorithm>
 #include <cassert>
-#include <deque>
-#include <queue>
+#include <functional>
 
 using namespace std;
 
 namespace merge_and_shrink {
 const int Distances::DISTANCE_UNKNOWN;
 
-  Distances::Distances(const TransitionSystem &transition_system, int global_cost_bound)
-  : transition_system(transition_system), 
-    per_bound_goal_distances(transition_system.get_size(), std::vector<std::pair<int,int>>()), 
-    global_cost_bound(global_cost_bound) {
-  clear_distances();
+void PerBoundDistances::assign(
+    int num_states, const vector<pair<int, pair<int, int>>> &entries) {
+    offsets.assign(num_states + 1, 0);
+    for (const auto &entry : entries)
+        ++offsets[entry.first + 1];
+    for (int state = 0; state < num_states; ++state)
+        offsets[state + 1] += offsets[state];
+
+    // Stable counting sort by state keeps the entries of a state in order.
+    bounds.resize(entries.size());
+    distances.resize(entries.size());
+    vector<int> next_entry(offsets.begin(), offsets.end() - 1);
+    for (const auto &entry : entries) {
+        int pos = next_entry[entry.first]++;
+        bounds[pos] = entry.second.first;
+        distances[pos] = entry.second.second;
+    }
+    bounds.shrink_to_fit();
+    distances.shrink_to_fit();
+}
+
+void PerBoundDistances::clear() {
+    utils::release_vector_memory(offsets);
+    utils::release_vector_memory(bounds);
+    utils::release_vector_memory(distances);
+}
+
+/*
+  Merge adjacent entries of the frontier [first, first + num_entries) until
+  at most max_entries are left, always merging the pair with the smallest
+  distance difference. Returns the new number of entries, which are moved
+  to the front of the range.
+*/
+static int compress_frontier(
+    int *bounds, int *distances, int num_entries, int max_entries) {
+    assert(max_entries >= 1);
+    if (num_entries <= max_entries)
+        return num_entries;
+
+    // Doubly-linked list of the remaining entries.
+    vector<int> prev(num_entries);
+    vector<int> next(num_entries);
+    vector<bool> removed(num_entries, false);
+    for (int i = 0; i < num_entries; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+
+    // Min-heap of (distance difference, (entry, successor entry)).
+    using HeapEntry = pair<int, pair<int, int>>;
+    vector<HeapEntry> heap;
+    heap.reserve(num_entries);
+    for (int i = 0; i + 1 < num_entries; ++i)
+        heap.push_back({distances[i] - distances[i + 1], {i, i + 1}});
+    make_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+
+    int num_remaining = num_entries;
+    while (num_remaining > max_entries) {
+        pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        HeapEntry top = heap.back();
+        heap.pop_back();
+        int i = top.second.first;
+        int j = top.second.second;
+        // Skip pairs that no longer exist or whose difference changed.
+        if (removed[i] || removed[j] || next[i] != j ||
+            distances[i] - distances[j] != top.first)
+            continue;
+
+        distances[i] = distances[j];
+        removed[j] = true;
+        next[i] = next[j];
+        if (next[j] < num_entries)
+            prev[next[j]] = i;
+        --num_remaining;
+
+        // Both neighbouring pairs of i have changed.
+        if (prev[i] != -1) {
+            heap.push_back({distances[prev[i]] - distances[i], {prev[i], i}});
+            push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        }
+        if (next[i] < num_entries) {
+            heap.push_back({distances[i] - distances[next[i]], {i, next[i]}});
+            push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        }
+    }
+
+    int num_kept = 0;
+    for (int i = 0; i < num_entries; ++i) {
+        if (!removed[i]) {
+            bounds[num_kept] = bounds[i];
+            distances[num_kept] = distances[i];
+            ++num_kept;
+        }
+    }
+    assert(num_kept == max_entries);
+    return num_kept;
+}
+
+int PerBoundDistances::compress(const FrontierLimits &limits) {
+    if (offsets.empty())
+        return 0;
+    int num_states = offsets.size() - 1;
+    int num_entries = bounds.size();
+
+    int max_frontier_size = limits.max_entries_per_state;
+    if (num_entries > limits.max_entries) {
+        /*
+          Find the largest frontier size k such that the sum of
+          min(size, k) over all frontiers is within the limit.
+        */
+        vector<int> num_frontiers_of_size;
+        for (int state = 0; state < num_states; ++state) {
+            int size = offsets[state + 1] - offsets[state];
+            if (size >= static_cast<int>(num_frontiers_of_size.size()))
+                num_frontiers_of_size.resize(size + 1, 0);
+            ++num_frontiers_of_size[size];
+        }
+        // total(k) = sum of min(size, k); num_larger = frontiers with size > k
+        long long total = 0;
+        int num_larger = num_states - num_frontiers_of_size[0];
+        int k = 0;
+        while (k + 1 < static_cast<int>(num_frontiers_of_size.size()) &&
+               total + num_larger <= limits.max_entries) {
+            total += num_larger;
+            ++k;
+            num_larger -= num_frontiers_of_size[k];
+        }
+        max_frontier_size = min(max_frontier_size, max(k, 1));
+    }
+    if (max_frontier_size == INF)
+        return 0;
+
+    int write_pos = 0;
+    for (int state = 0; state < num_states; ++state) {
+        int begin = offsets[state];
+        int size = offsets[state + 1] - begin;
+        // The entries of earlier states have only moved to the front.
+        offsets[state] = write_pos;
+        if (begin != write_pos) {
+            copy(bounds.begin() + begin, bounds.begin() + begin + size,
+                 bounds.begin() + write_pos);
+            copy(distances.begin() + begin, distances.begin() + begin + size,
+                 distances.begin() + write_pos);
+        }
+        write_pos += compress_frontier(
+            bounds.data() + write_pos, distances.data() + write_pos,
+            size, max_frontier_size);
+    }
+    offsets[num_states] = write_pos;
+    bounds.resize(write_pos);
+    distances.resize(write_pos);
+    bounds.shrink_to_fit();
+    distances.shrink_to_fit();
+    return num_entries - write_pos;
+}
+
+pair<int, int> PerBoundDistances::get_bound_interval(int state, int cost_bound) const {
+    assert(state >= 0 && state + 1 < static_cast<int>(offsets.size()));
+    auto begin = bounds.begin() + offsets[state];
+    auto end = bounds.begin() + offsets[state + 1];
+    // First entry whose bound exceeds cost_bound.
+    auto next = upper_bound(begin, end, cost_bound);
+    int min_bound = (next == begin) ? numeric_limits<int>::min() : *(next - 1);
+    int max_bound = (next == end) ? numeric_limits<int>::max() : *next - 1;
+    return make_pair(min_bound, max_bound);
+}
+
+vector<pair<int, int>> PerBoundDistances::get_frontier(int state) const {
+    vector<pair<int, int>> frontier;
+    frontier.reserve(offsets[state + 1] - offsets[state]);
+    for (int pos = offsets[state]; pos < offsets[state + 1]; ++pos)
+        frontier.emplace_back(bounds[pos], distances[pos]);
+    return frontier;
+}
+
+Distances::Distances(
+    const TransitionSystem &transition_system, int global_cost_bound,
+    int num_threads, const FrontierLimits &frontier_limits)
+    : transition_system(transition_system),
+      global_cost_bound(global_cost_bound),
+      num_threads(num_threads),
+      frontier_limits(frontier_limits) {
+    clear_distances();
 }
 
 void Distances::clear_distances() {
@@ -32,133 +213,143 @@ int Distances::get_num_states() const {
     return transition_system.get_size();
 }
 
-  using TransitionGraph = std::vector<std::vector<std::pair<int, std::pair<int,int>>>>;
-
-TransitionGraph get_transition_graph(const TransitionSystem& ts,
-				     bool reverse) {
-  TransitionGraph tg(ts.get_size());
-  for (const GroupAndTransitions &gat : ts) {
-    const LabelGroup &label_group = gat.label_group;
-    const vector<Transition> &transitions = gat.transitions;
-    for (const Transition &transition : transitions) {
-      if (transition.src == transition.target) continue;
-
-      int source = reverse ? transition.target : transition.src;
-      int target = reverse ? transition.src : transition.target;
+/*
+  Transitions of a transition system (or of its reverse) without
+  self-loops, in compressed sparse row format: the outgoing edges of state s
+  are edges[offsets[s]], ..., edges[offsets[s + 1] - 1].
+*/
+struct TransitionGraph {
+    struct Edge {
+        int target;
+        int secondary_cost;
+        int cost;
+    };
 
-      tg[source].push_back({target, {label_group.get_secondary_cost(), label_group.get_cost()}});      
+    vector<int> offsets;
+    vector<Edge> edges;
+
+    TransitionGraph(const TransitionSystem &ts, bool reverse) {
+        int num_states = ts.get_size();
+        offsets.assign(num_states + 1, 0);
+        for (const GroupAndTransitions &gat : ts) {
+            for (const Transition &transition : gat.transitions) {
+                if (transition.src != transition.target) {
+                    int source = reverse ? transition.target : transition.src;
+                    ++offsets[source + 1];
+                }
+            }
+        }
+        for (int state = 0; state < num_states; ++state)
+            offsets[state + 1] += offsets[state];
+
+        edges.resize(offsets[num_states]);
+        vector<int> next_edge(offsets.begin(), offsets.end() - 1);
+        for (const GroupAndTransitions &gat : ts) {
+            const LabelGroup &label_group = gat.label_group;
+            int secondary_cost = label_group.get_secondary_cost();
+            int cost = label_group.get_cost();
+            for (const Transition &transition : gat.transitions) {
+                if (transition.src != transition.target) {
+                    int source = reverse ? transition.target : transition.src;
+                    int target = reverse ? transition.src : transition.target;
+                    edges[next_edge[source]++] = {target, secondary_cost, cost};
+                }
+            }
+        }
     }
-  }
-  
-  return tg;
-}
 
-void compute_per_bound_distances_internal(const TransitionGraph& tg, 
-					  const std::vector<int>& starting_states, 
-					  std::vector<std::vector<std::pair<int,int> > >& distances, 
-					  int cost_bound) {
-  struct PQEntry {
-    int state;
-    std::pair<int,int> costs; // <secondary_cost, primary_cost>
-    
-    bool operator> (const PQEntry& other) const {
-      if (costs.first > other.costs.first) return true;
-      if (costs.first == other.costs.first && costs.second > other.costs.second) return true;
-      return false;
-    };
-  };
-  
-  std::priority_queue<PQEntry, std::vector<PQEntry>, std::greater<PQEntry>> queue;
-  
-  for (int state : starting_states) {
-    //    cout << "Init of state " << state << " with costs (0,0)" << endl;
-    queue.push({state, {0, 0}});
-  }
-    
-  while (!queue.empty()) {
-    PQEntry pq_entry = queue.top();
-    queue.pop();
-    
-    std::vector<std::pair<int, int>>& state_dists = distances[pq_entry.state];
-
-//     cout << "Popped state " << pq_entry.state << " with current cost vector ";
-//     for (const auto& entry : state_dists) {
-//       cout << "(" << entry.first << ", " << entry.second << "), ";
-//     }
-//     cout << endl;
-    
-    if (state_dists.empty() || 
-	// previously discovered at a lower bounded cost with higher primary cost. 
-	(state_dists.back().first < pq_entry.costs.first &&
-	 state_dists.back().second > pq_entry.costs.second)) {
-      state_dists.push_back(pq_entry.costs);
-	
-      for (const std::pair<int, std::pair<int, int>>& adj_state : tg[pq_entry.state]) {
-	// Ignore self loops
-	if (adj_state.first == pq_entry.state) continue;
-	if (pq_entry.costs.first + adj_state.second.first > cost_bound) continue;
-	
-	queue.push({adj_state.first, 
-	      {pq_entry.costs.first + adj_state.second.first, 
-		  pq_entry.costs.second + adj_state.second.second}});
-      }
+    int get_num_states() const {
+        return offsets.size() - 1;
+    }
+};
+
+/*
+  Pareto-optimal (secondary cost, cost) distances from the starting states,
+  ignoring paths whose secondary cost exceeds cost_bound.
+
+  The search is bucket-synchronous over the secondary cost: bucket b holds
+  the (cost, state) pairs reached with secondary cost b as a heap ordered by
+  cost. Buckets are processed in order of increasing secondary cost, and each
+  one is exhausted (including entries added via edges of secondary cost 0)
+  before moving on, so every state is settled in lexicographic order of its
+  (secondary cost, cost) pairs.
+*/
+static void compute_per_bound_distances_internal(
+    const TransitionGraph &tg, const vector<int> &starting_states,
+    PerBoundDistances &distances, int cost_bound) {
+    using HeapEntry = pair<int, int>; // <cost, state>
+    vector<vector<HeapEntry>> buckets(1);
+    for (int state : starting_states) {
+        buckets[0].push_back({0, state});
     }
-  }
 
-//   for (size_t i = 0; i < tg.size(); ++i) {
-//     cout << "Final entry for state " << i << ": ";
-//     for (const auto& entry : distances[i]) {
-//       cout << "(" << entry.first << ", " << entry.second << "), ";
-//     }
-//     cout << endl;
-//   }
+    /*
+      We only need to remember the last entry of each state while searching
+      and collect all entries in one array, which is packed afterwards.
+    */
+    int num_states = tg.get_num_states();
+    vector<pair<int, int>> last_entry(num_states, {-1, -1});
+    vector<pair<int, pair<int, int>>> entries;
+
+    for (size_t secondary_cost = 0; secondary_cost < buckets.size(); ++secondary_cost) {
+        vector<HeapEntry> heap;
+        heap.swap(buckets[secondary_cost]);
+        make_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+            int cost = heap.back().first;
+            int state = heap.back().second;
+            heap.pop_back();
+
+            pair<int, int> &last = last_entry[state];
+            if (last.first != -1 &&
+                // Only keep entries with a lower cost than all entries with
+                // a lower secondary cost (or the same one).
+                (last.first == static_cast<int>(secondary_cost) || last.second <= cost))
+                continue;
+            last = {secondary_cost, cost};
+            entries.push_back({state, last});
+
+            for (int i = tg.offsets[state]; i < tg.offsets[state + 1]; ++i) {
+                const TransitionGraph::Edge &edge = tg.edges[i];
+                if (edge.secondary_cost == 0) {
+                    heap.push_back({cost + edge.cost, edge.target});
+                    push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+                } else {
+                    if (edge.secondary_cost > cost_bound - static_cast<int>(secondary_cost))
+                        continue;
+                    int succ_secondary_cost = secondary_cost + edge.secondary_cost;
+                    if (succ_secondary_cost >= static_cast<int>(buckets.size()))
+                        buckets.resize(succ_secondary_cost + 1);
+                    buckets[succ_secondary_cost].push_back({cost + edge.cost, edge.target});
+                }
+            }
+        }
+    }
 
-}		       
+    distances.assign(num_states, entries);
+}
 
 void Distances::compute_goal_distances_general_cost() {
-  TransitionGraph tg = get_transition_graph(transition_system, true);
+    TransitionGraph tg(transition_system, true);
 
-  std::vector<int> goal_states;
-  for (int state = 0; state < get_num_states(); ++state) {
-    if (transition_system.is_goal_state(state)) {
-      goal_states.push_back(state);
+    vector<int> goal_states;
+    for (int state = 0; state < get_num_states(); ++state) {
+        if (transition_system.is_goal_state(state)) {
+            goal_states.push_back(state);
+        }
     }
-  }
-  compute_per_bound_distances_internal(tg, goal_states, per_bound_goal_distances, global_cost_bound);
+    compute_per_bound_distances_internal(tg, goal_states, per_bound_goal_distances, global_cost_bound);
+    per_bound_goal_distances.compress(frontier_limits);
 }
 
 void Distances::compute_init_distances_general_cost() {
-  TransitionGraph tg = get_transition_graph(transition_system, false);
-
-  std::vector<int> init_states = {transition_system.get_init_state()};
+    TransitionGraph tg(transition_system, false);
 
-  compute_per_bound_distances_internal(tg, init_states, per_bound_init_distances, global_cost_bound);
-}
-
-int get_distance(const std::vector<std::pair<int,int>>& state_bounds_and_dists, 
-		 int cost_bound) {      
-  size_t first_entry_exceeding_bound = 0;
-  while (first_entry_exceeding_bound < state_bounds_and_dists.size() &&
-	 state_bounds_and_dists[first_entry_exceeding_bound].first <= cost_bound) {
-    ++first_entry_exceeding_bound;
-  }
-  
-  if (first_entry_exceeding_bound == 0) return INF;
-  
-  return state_bounds_and_dists[first_entry_exceeding_bound - 1].second;
-}
-
-int Distances::get_goal_distance(int state, int cost_bound) const {
-  const std::vector<std::pair<int,int>>& state_bounds_and_goal_dists = 
-    per_bound_goal_distances[state];
+    vector<int> init_states = {transition_system.get_init_state()};
 
-  return get_distance(state_bounds_and_goal_dists, cost_bound);
-}
-
-int Distances::get_init_distance(int state, int cost_bound) const {
-  const std::vector<std::pair<int,int>>& state_bounds_and_init_dists = 
-    per_bound_init_distances[state];
-  return get_distance(state_bounds_and_init_dists, cost_bound);
+    compute_per_bound_distances_internal(tg, init_states, per_bound_init_distances, global_cost_bound);
+    per_bound_init_distances.compress(frontier_limits);
 }
 
 bool Distances::is_unit_cost() const {
@@ -198,7 +389,7 @@ void Distances::compute_distances(
           distances have been computed during the merge-and-shrink computation.
         */
         assert(!are_goal_distances_computed());
-        assert(goal_distances.empty());
+        assert(per_bound_goal_distances.empty());
         assert(!compute_init_distances);
         assert(compute_goal_distances);
     } else {
@@ -207,7 +398,7 @@ void Distances::compute_distances(
           distance information must have been cleared before.
         */
         assert(!are_init_distances_computed() && !are_goal_distances_computed());
-        assert(init_distances.empty() && goal_distances.empty());
+        assert(per_bound_init_distances.empty() && per_bound_goal_distances.empty());
     }
 
     if (verbosity >= Verbosity::VERBOSE) {
@@ -223,12 +414,6 @@ void Distances::compute_distances(
         return;
     }
 
-    if (compute_init_distances) {
-      per_bound_init_distances.resize(num_states, std::vector<std::pair<int,int>>());
-    }
-    if (compute_goal_distances) {
-        per_bound_goal_distances.resize(num_states, std::vector<std::pair<int,int>>());
-    }
     if (verbosity >= Verbosity::VERBOSE) {
         cout << "computing ";
         if (compute_init_distances && compute_goal_distances) {
@@ -244,11 +429,21 @@ void Distances::compute_distances(
     if (verbosity >= Verbosity::VERBOSE) {
       cout << "general-cost";
     }
-    if (compute_init_distances) {
-      compute_init_distances_general_cost();
-    }
-    if (compute_goal_distances) {
-      compute_goal_distances_general_cost();
+    if (compute_init_distances && compute_goal_distances && num_threads > 1) {
+        // The two searches are independent.
+        utils::parallel_for(2, 2, [this](int direction) {
+                if (direction == 0)
+                    compute_init_distances_general_cost();
+                else
+                    compute_goal_distances_general_cost();
+            });
+    } else {
+        if (compute_init_distances) {
+            compute_init_distances_general_cost();
+        }
+        if (compute_goal_distances) {
+            compute_goal_distances_general_cost();
+        }
     }
 
     if (verbosity >= Verbosity::VERBOSE) {
@@ -303,7 +498,8 @@ void Distances::statistics() const {
     if (!are_goal_distances_computed()) {
         cout << "goal distances not computed";
     } else if (transition_system.is_solvable(*this)) {
-        cout << "init h=" << get_goal_distance(transition_system.get_init_state());
+        cout << "init h=" << get_goal_distance(transition_system.get_init_state())
+             << ", goal distance entries=" << per_bound_goal_distances.get_num_entries();
     } else {
         cout << "transition system is unsolvable";
     }
@@ -23,6 +23,80 @@ struct bnode {
     int secondary_cost;
 };
 
+/*
+  Pareto frontiers of (secondary cost bound, distance) pairs of all states
+  of a transition system. The entries of a state are sorted by increasing
+  bound (and strictly decreasing distance): the distance of a state under a
+  bound is the distance of the last entry whose bound does not exceed it,
+  or INF if there is no such entry.
+
+  All frontiers are packed into flat arrays (compressed sparse row format):
+  the entries of state s are at positions [offsets[s], offsets[s + 1]).
+  Bounds and distances are stored separately, so that the search for the
+  bound only touches the bounds array.
+*/
+class PerBoundDistances {
+    std::vector<int> offsets;
+    std::vector<int> bounds;
+    std::vector<int> distances;
+public:
+    /*
+      Build the frontiers of num_states states from their entries, given as
+      (state, bound, distance) triples that are sorted by increasing bound
+      for each state.
+    */
+    void assign(int num_states,
+                const std::vector<std::pair<int, std::pair<int, int>>> &entries);
+    void clear();
+
+    /*
+      Reduce the number of entries to the given limits by merging adjacent
+      entries of a frontier: entries (b1, d1) and (b2, d2) with b1 < b2 are
+      replaced by (b1, d2). This underestimates the distance for bounds in
+      [b1, b2) and leaves all other distances unchanged, so the compressed
+      distances are still admissible. In particular, a state has distance
+      INF under exactly the same bounds as before. Each frontier is reduced
+      by greedily merging the adjacent pair with the smallest distance
+      difference. If the total number of entries exceeds limits.max_entries,
+      all frontiers are capped at the largest common size for which the
+      total fits (but at least one entry is kept per reached state).
+
+      Returns the number of removed entries.
+    */
+    int compress(const FrontierLimits &limits);
+
+    bool empty() const {
+        return offsets.empty();
+    }
+
+    int get_distance(int state, int cost_bound) const {
+        assert(state >= 0 && state + 1 < static_cast<int>(offsets.size()));
+        const int *base = bounds.data() + offsets[state];
+        int num_entries = offsets[state + 1] - offsets[state];
+        if (num_entries == 0 || base[0] > cost_bound)
+            return INF;
+        // Branch-free binary search for the last entry with bound <= cost_bound.
+        while (num_entries > 1) {
+            int half = num_entries / 2;
+            base = (base[half] <= cost_bound) ? base + half : base;
+            num_entries -= half;
+        }
+        return distances[base - bounds.data()];
+    }
+
+    /*
+      Return the interval of bounds under which the state has the same
+      distance as under cost_bound.
+    */
+    std::pair<int, int> get_bound_interval(int state, int cost_bound) const;
+
+    std::vector<std::pair<int, int>> get_frontier(int state) const;
+
+    size_t get_num_entries() const {
+        return bounds.size();
+    }
+};
+
 class TransitionSystem;
 class Distances {
     static const int DISTANCE_UNKNOWN = -1;
@@ -40,19 +114,18 @@ class Distances {
 
 
 
-    std::vector<std::vector<std::pair<int, int>>> final_entry_backward_graph;
-    std::vector<std::vector<int>> init_distances_bounded_cost;
-
+    PerBoundDistances per_bound_goal_distances;
+    PerBoundDistances per_bound_init_distances;
 
-    mutable std::vector<std::vector<std::pair<int,int>>> per_bound_goal_distances;
-    mutable std::vector<std::vector<std::pair<int,int>>> per_bound_init_distances;
-
-    std::vector<std::vector<std::pair<int, std::pair<int,int>>>> reverse_transition_graph;
     int global_cost_bound = std::numeric_limits<int>::max();
-    
+    // Number of threads for computing init and goal distances concurrently.
+    int num_threads;
+    FrontierLimits frontier_limits;
 
 public:
-    explicit Distances(const TransitionSystem &transition_system, int global_cost_bound);
+    Distances(const TransitionSystem &transition_system, int global_cost_bound,
+              int num_threads = 1,
+              const FrontierLimits &frontier_limits = FrontierLimits());
     ~Distances() = default;
 
     bool are_init_distances_computed() const {
@@ -87,11 +160,24 @@ public:
         bool compute_goal_distances,
         Verbosity verbosity);
 
-    int get_init_distance(int state, int cost_bound = std::numeric_limits<int>::max()) const;
-    int get_goal_distance(int state, int cost_bound = std::numeric_limits<int>::max()) const;
+    int get_init_distance(int state, int cost_bound = std::numeric_limits<int>::max()) const {
+        assert(are_init_distances_computed());
+        return per_bound_init_distances.get_distance(state, cost_bound);
+    }
+
+    int get_goal_distance(int state, int cost_bound = std::numeric_limits<int>::max()) const {
+        assert(are_goal_distances_computed());
+        return per_bound_goal_distances.get_distance(state, cost_bound);
+    }
+
+    std::pair<int, int> get_goal_distance_bound_interval(int state, int cost_bound) const {
+        assert(are_goal_distances_computed());
+        return per_bound_goal_distances.get_bound_interval(state, cost_bound);
+    }
 
-    const std::vector<std::pair<int,int>>& get_per_bound_distances(int state) const {
-      return per_bound_goal_distances[state];
+    // Pareto frontier of (bound, goal distance) pairs of the given state.
+    std::vector<std::pair<int, int>> get_per_bound_distances(int state) const {
+        return per_bound_goal_distances.get_frontier(state);
     }
 
     void dump() const;
@@ -8,8 +8,10 @@
 
 #include "../utils/collections.h"
 #include "../utils/memory.h"
+#include "../utils/parallel.h"
 #include "../utils/system.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -43,6 +45,8 @@ FactoredTransitionSystem::FactoredTransitionSystem(
     const bool compute_init_distances,
     const bool compute_goal_distances,
     int cost_bound,
+    int num_threads,
+    const FrontierLimits &frontier_limits,
     Verbosity verbosity)
     : labels(move(labels)),
       transition_systems(move(transition_systems)),
@@ -51,12 +55,26 @@ FactoredTransitionSystem::FactoredTransitionSystem(
       compute_init_distances(compute_init_distances),
       compute_goal_distances(compute_goal_distances),
       num_active_entries(this->transition_systems.size()), 
-      cost_bound(cost_bound) {
+      cost_bound(cost_bound),
+      num_threads(num_threads),
+      frontier_limits(frontier_limits) {
+    if (compute_init_distances || compute_goal_distances) {
+        /*
+          The distances of the atomic factors are independent of each other.
+          Their computation only produces output in verbose mode, which we
+          suppress when using several threads to avoid interleaved lines.
+        */
+        Verbosity distances_verbosity = verbosity;
+        if (num_threads > 1)
+            distances_verbosity = min(verbosity, Verbosity::NORMAL);
+        utils::parallel_for(
+            this->distances.size(), num_threads, [&](int index) {
+                this->distances[index]->compute_distances(
+                    compute_init_distances, compute_goal_distances,
+                    distances_verbosity);
+            });
+    }
     for (size_t index = 0; index < this->transition_systems.size(); ++index) {
-        if (compute_init_distances || compute_goal_distances) {
-            this->distances[index]->compute_distances(
-                compute_init_distances, compute_goal_distances, verbosity);
-        }
         assert(is_component_valid(index));
     }
 }
@@ -68,7 +86,10 @@ FactoredTransitionSystem::FactoredTransitionSystem(FactoredTransitionSystem &&ot
       distances(move(other.distances)),
       compute_init_distances(move(other.compute_init_distances)),
       compute_goal_distances(move(other.compute_goal_distances)),
-      num_active_entries(move(other.num_active_entries)) {
+      num_active_entries(move(other.num_active_entries)),
+      cost_bound(move(other.cost_bound)),
+      num_threads(move(other.num_threads)),
+      frontier_limits(move(other.frontier_limits)) {
     /*
       This is just a default move constructor. Unfortunately Visual
       Studio does not support "= default" for move construction or
@@ -185,7 +206,9 @@ int FactoredTransitionSystem::merge(
     mas_representations[index1] = nullptr;
     mas_representations[index2] = nullptr;
     const TransitionSystem &new_ts = *transition_systems.back();
-    distances.push_back(utils::make_unique_ptr<Distances>(new_ts, get_cost_bound()));
+    distances.push_back(
+        utils::make_unique_ptr<Distances>(
+            new_ts, get_cost_bound(), num_threads, frontier_limits));
     int new_index = transition_systems.size() - 1;
     // Restore the invariant that distances are computed.
     if (compute_init_distances || compute_goal_distances) {
@@ -52,6 +52,9 @@ class FactoredTransitionSystem {
     int num_active_entries;
 
     int cost_bound;
+    // Number of threads for distance computations.
+    int num_threads;
+    FrontierLimits frontier_limits;
 
     /*
       Assert that the factor at the given index is in a consistent state, i.e.
@@ -76,6 +79,8 @@ public:
         bool compute_init_distances,
         bool compute_goal_distances,
 	int cost_bound,
+        int num_threads,
+        const FrontierLimits &frontier_limits,
         Verbosity verbosity);
     FactoredTransitionSystem(FactoredTransitionSystem &&other);
     ~FactoredTransitionSystem();
@@ -171,6 +176,10 @@ public:
     bool is_active(int index) const;
 
     int get_cost_bound() const { return cost_bound; }
+
+    const FrontierLimits &get_frontier_limits() const {
+        return frontier_limits;
+    }
 };
 }
 
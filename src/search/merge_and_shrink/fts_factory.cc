@@ -74,7 +74,8 @@ class FTSFactory {
     vector<unique_ptr<TransitionSystem>> create_transition_systems();
     vector<unique_ptr<MergeAndShrinkRepresentation>> create_mas_representations();
     vector<unique_ptr<Distances>> create_distances(const vector<unique_ptr<TransitionSystem>> &transition_systems,
-						   int cost_bound);
+						   int cost_bound,
+						   const FrontierLimits &frontier_limits);
 public:
     explicit FTSFactory(const TaskProxy &task_proxy);
     ~FTSFactory();
@@ -87,6 +88,8 @@ public:
         bool compute_init_distances,
         bool compute_goal_distances,
 	int cost_bound,
+        int num_threads,
+        const FrontierLimits &frontier_limits,
         Verbosity verbosity);
 };
 
@@ -380,7 +383,8 @@ vector<unique_ptr<MergeAndShrinkRepresentation>> FTSFactory::create_mas_represen
 
 vector<unique_ptr<Distances>> FTSFactory::create_distances(
   const vector<unique_ptr<TransitionSystem>> &transition_systems,
-  int cost_bound) {
+  int cost_bound,
+  const FrontierLimits &frontier_limits) {
     // Create the actual Distances objects.
     int num_variables = task_proxy.get_variables().size();
 
@@ -391,7 +395,7 @@ vector<unique_ptr<Distances>> FTSFactory::create_distances(
 
     for (int var_no = 0; var_no < num_variables; ++var_no) {
         result.push_back(utils::make_unique_ptr<Distances>(*transition_systems[var_no],
-							   cost_bound));
+							   cost_bound, 1, frontier_limits));
     }
     return result;
 }
@@ -400,6 +404,8 @@ FactoredTransitionSystem FTSFactory::create(
     const bool compute_init_distances,
     const bool compute_goal_distances,
     int cost_bound,
+    int num_threads,
+    const FrontierLimits &frontier_limits,
     Verbosity verbosity) {
     if (verbosity >= Verbosity::NORMAL) {
         cout << "Building atomic transition systems... " << endl;
@@ -414,7 +420,7 @@ FactoredTransitionSystem FTSFactory::create(
     vector<unique_ptr<MergeAndShrinkRepresentation>> mas_representations =
         create_mas_representations();
     vector<unique_ptr<Distances>> distances =
-      create_distances(transition_systems, cost_bound);
+      create_distances(transition_systems, cost_bound, frontier_limits);
 
     return FactoredTransitionSystem(
         move(labels),
@@ -424,6 +430,8 @@ FactoredTransitionSystem FTSFactory::create(
         compute_init_distances,
         compute_goal_distances,
 	cost_bound,
+        num_threads,
+        frontier_limits,
         verbosity);
 }
 
@@ -432,11 +440,15 @@ FactoredTransitionSystem create_factored_transition_system(
     const bool compute_init_distances,
     const bool compute_goal_distances,
     int cost_bound,
+    int num_threads,
+    const FrontierLimits &frontier_limits,
     Verbosity verbosity) {
     return FTSFactory(task_proxy).create(
         compute_init_distances,
         compute_goal_distances,
 	cost_bound,
+        num_threads,
+        frontier_limits,
         verbosity);
 }
 }
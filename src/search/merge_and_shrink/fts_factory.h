@@ -15,6 +15,7 @@ class TaskProxy;
 
 namespace merge_and_shrink {
 class FactoredTransitionSystem;
+struct FrontierLimits;
 enum class Verbosity;
 
 extern FactoredTransitionSystem create_factored_transition_system(
@@ -22,6 +23,8 @@ extern FactoredTransitionSystem create_factored_transition_system(
     bool compute_init_distances,
     bool compute_goal_distances,
     int cost_bound,
+    int num_threads,
+    const FrontierLimits &frontier_limits,
     Verbosity verbosity);
 }
 
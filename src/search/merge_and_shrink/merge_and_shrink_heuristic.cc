@@ -50,6 +50,8 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const Options &opts)
       prune_irrelevant_states(opts.get<bool>("prune_irrelevant_states")),
       verbosity(static_cast<Verbosity>(opts.get_enum("verbosity"))),
       main_loop_max_time(opts.get<double>("main_loop_max_time")),
+      main_loop_max_memory(opts.get<int>("main_loop_max_memory")),
+      num_threads(opts.get<int>("num_threads")),
       starting_peak_memory(-1),
       mas_representation(nullptr), 
       use_cost_bound(opts.get<bool>("use_cost_bound")) {
@@ -57,6 +59,15 @@ MergeAndShrinkHeuristic::MergeAndShrinkHeuristic(const Options &opts)
     assert(max_states >= max_states_before_merge);
     assert(shrink_threshold_before_merge <= max_states_before_merge);
 
+    frontier_limits.max_entries_per_state = opts.get<int>("max_frontier_size");
+    int max_frontier_memory = opts.get<int>("max_frontier_memory");
+    if (max_frontier_memory != INF) {
+        // Each entry consists of a bound and a distance.
+        const long long bytes_per_entry = 2 * sizeof(int);
+        frontier_limits.max_entries = min<long long>(
+            INF - 1, max_frontier_memory * 1024LL * 1024LL / bytes_per_entry);
+    }
+
     if (opts.contains("label_reduction")) {
         label_reduction = opts.get<shared_ptr<LabelReduction>>("label_reduction");
         label_reduction->initialize(task_proxy);
@@ -126,6 +137,18 @@ void MergeAndShrinkHeuristic::dump_options() const {
         break;
     }
     cout << endl;
+
+    cout << "Threads for distance computations: " << num_threads << endl;
+
+    cout << "Maximum number of entries per state in distance tables: "
+         << frontier_limits.max_entries_per_state << endl;
+    cout << "Maximum number of entries per distance table: "
+         << frontier_limits.max_entries << endl;
+    cout << "Main loop memory limit: ";
+    if (main_loop_max_memory == INF)
+        cout << "infinity" << endl;
+    else
+        cout << main_loop_max_memory << " MB" << endl;
 }
 
 void MergeAndShrinkHeuristic::warn_on_unusual_options() const {
@@ -179,6 +202,19 @@ bool MergeAndShrinkHeuristic::ran_out_of_time(
     return false;
 }
 
+bool MergeAndShrinkHeuristic::ran_out_of_memory() const {
+    if (main_loop_max_memory != INF &&
+        utils::get_peak_memory_in_kb() - starting_peak_memory >
+        main_loop_max_memory * 1024LL) {
+        if (verbosity >= Verbosity::NORMAL) {
+            cout << "Ran out of memory, stopping computation." << endl;
+            cout << endl;
+        }
+        return true;
+    }
+    return false;
+}
+
 
 void MergeAndShrinkHeuristic::finalize_factor(
     FactoredTransitionSystem &fts, int index) {
@@ -266,6 +302,9 @@ int MergeAndShrinkHeuristic::main_loop(
         if (ran_out_of_time(ctimer)) {
             break;
         }
+        if (ran_out_of_memory()) {
+            break;
+        }
         int merge_index1 = merge_indices.first;
         int merge_index2 = merge_indices.second;
         assert(merge_index1 != merge_index2);
@@ -429,6 +468,8 @@ void MergeAndShrinkHeuristic::build(const utils::Timer &timer) {
             compute_init_distances,
             compute_goal_distances,
 	    cost_bound,
+            num_threads,
+            frontier_limits,
             verbosity);
     if (verbosity >= Verbosity::NORMAL) {
         print_time(timer, "after computation of atomic transition systems");
@@ -471,6 +512,10 @@ int MergeAndShrinkHeuristic::compute_heuristic_w_bound(const GlobalState &global
 
     State state = convert_global_state(global_state);
     int abstract_state = mas_representation->get_value(state);
+    if (abstract_state == PRUNED_STATE) {
+        set_valid_bounds(numeric_limits<int>::min(), numeric_limits<int>::max());
+        return DEAD_END;
+    }
 
     // Recomputing goal distances from the current state, using cost bound for the secondary cost function
     // mas_distances->recompute_goal_distances(abstract_state, cost_bound);
@@ -478,6 +523,11 @@ int MergeAndShrinkHeuristic::compute_heuristic_w_bound(const GlobalState &global
     //cout << "Abstract state: " << abstract_state << endl;
     cost_bound = use_cost_bound ? cost_bound : std::numeric_limits<int>::max();
     int cost = mas_distances->get_goal_distance(abstract_state, cost_bound);
+    if (use_cost_bound) {
+        pair<int, int> bounds =
+            mas_distances->get_goal_distance_bound_interval(abstract_state, cost_bound);
+        set_valid_bounds(bounds.first, bounds.second);
+    }
     if (cost == PRUNED_STATE || cost == INF) {
         // If state is unreachable or irrelevant, we encountered a dead end.
       cout << "returning DEAD_END" << endl;
@@ -701,6 +751,40 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.add_option<bool>("use_cost_bound",
 			    "Use or ignore passed in secondary cost bound", "true");
 
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads used for computing the init and goal distances "
+        "of factors. The distances of all atomic factors are computed "
+        "concurrently, and for each later factor, init and goal distances "
+        "are computed concurrently.",
+        "1",
+        Bounds("1", "infinity"));
+
+    parser.add_option<int>(
+        "max_frontier_size",
+        "maximum number of (bound, distance) entries per abstract state in "
+        "the per-bound init and goal distance tables. Larger frontiers are "
+        "compressed by merging adjacent entries, which weakens the heuristic "
+        "but keeps it admissible.",
+        "infinity",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "max_frontier_memory",
+        "memory limit in MB for the entries of each per-bound distance "
+        "table. Tables exceeding it are compressed like with "
+        "max_frontier_size, using the largest frontier size for which the "
+        "table fits.",
+        "infinity",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "main_loop_max_memory",
+        "A limit in MB on the peak memory increase of the merge-and-shrink "
+        "computation. If the limit is exceeded, the main loop terminates "
+        "like with main_loop_max_time. The limit is only checked before each "
+        "merge, so it can be exceeded by the current transformation.",
+        "infinity",
+        Bounds("0", "infinity"));
+
     parser.add_option<double>(
         "main_loop_max_time",
         "A limit in seconds on the runtime of the main loop of the algorithm. "
@@ -1,6 +1,8 @@
 #ifndef MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 #define MERGE_AND_SHRINK_MERGE_AND_SHRINK_HEURISTIC_H
 
+#include "types.h"
+
 #include "../heuristic.h"
 
 #include <memory>
@@ -42,6 +44,10 @@ class MergeAndShrinkHeuristic : public Heuristic {
 
     const Verbosity verbosity;
     const double main_loop_max_time;
+    // Limit on the peak memory increase of the main loop in MB.
+    const int main_loop_max_memory;
+    const int num_threads;
+    FrontierLimits frontier_limits;
 
     long starting_peak_memory;
     // The final merge-and-shrink representation, storing goal distances.
@@ -58,6 +64,7 @@ class MergeAndShrinkHeuristic : public Heuristic {
     void dump_options() const;
     void warn_on_unusual_options() const;
     bool ran_out_of_time(const utils::CountdownTimer &timer) const;
+    bool ran_out_of_memory() const;
 
     bool use_cost_bound;
 
@@ -65,24 +72,13 @@ protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
     virtual int compute_heuristic_w_bound(const GlobalState &state, int cost_bound) override;
 public:
-    virtual void notify_state_transition(const GlobalState &parent_state, OperatorID op_id,
-					 const GlobalState &state) override{
-      (void) parent_state;
-      (void) op_id;
-      if (cache_evaluator_values && use_cost_bound) {
-        /* TODO:  It may be more efficient to check that the reached landmark
-           set has actually changed and only then mark the h value as dirty. */
-        heuristic_cache[state].dirty = true;
-      }
-    }
-    
-    virtual void get_path_dependent_evaluators(
-        std::set<Evaluator *> &evals) override {
-        evals.insert(this);
-    }
-
     explicit MergeAndShrinkHeuristic(const options::Options &opts);
     virtual ~MergeAndShrinkHeuristic() override = default;
+
+    virtual bool depends_on_cost_bound() const override {
+        return use_cost_bound;
+    }
+
     static void add_shrink_limit_options_to_parser(options::OptionParser &parser);
     static void handle_shrink_limit_options_defaults(options::Options &opts);
 };
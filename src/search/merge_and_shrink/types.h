@@ -22,6 +22,20 @@ extern const int PRUNED_STATE;
 using StateEquivalenceClass = std::forward_list<int>;
 using StateEquivalenceRelation = std::vector<StateEquivalenceClass>;
 
+/*
+  Limits on the size of the per-bound distance tables of a factor, in
+  number of (bound, distance) entries per state and in total per table.
+*/
+struct FrontierLimits {
+    int max_entries_per_state;
+    int max_entries;
+
+    FrontierLimits()
+        : max_entries_per_state(INF),
+          max_entries(INF) {
+    }
+};
+
 enum class Verbosity {
     SILENT,
     NORMAL,
@@ -91,6 +91,13 @@ public:
     virtual void get_path_dependent_evaluators(
         std::set<Evaluator *> &evals) = 0;
 
+    /*
+      Add all evaluators that this open list uses (directly or indirectly)
+      and that benefit from evaluating several states at once into the
+      result set (see Evaluator::get_batch_evaluators).
+    */
+    virtual void get_batch_evaluators(std::set<Evaluator *> &evals) = 0;
+
     /*
       Accessor method for only_preferred.
 
@@ -0,0 +1,362 @@
+#include "bucket_tiebreaking_open_list.h"
+
+#include "../evaluator.h"
+#include "../open_list.h"
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_tiebreaking_open_list {
+/*
+  Tie-breaking open list for small integer keys. It removes entries in the
+  same order as TieBreakingOpenList (lexicographically smallest key first,
+  FIFO among equal keys), but stores the entries in a trie of bucket
+  arrays instead of a map from key vectors to buckets: the children of a
+  node at depth d are indexed by the value of the d-th evaluator, and the
+  children at the last depth are the buckets. For A*, this is an array of
+  f layers, each of which is an array of h layers, and so on.
+
+  Keys with values outside of [0, MAX_DENSE_VALUE) (e.g., infinite values
+  of unsafe heuristics) are kept in a map as in TieBreakingOpenList.
+*/
+template<class Entry>
+class BucketTieBreakingOpenList : public OpenList<Entry> {
+    using Bucket = deque<Entry>;
+
+    static const int MAX_DENSE_VALUE = 1 << 16;
+    static const int NO_CHILD = -1;
+
+    struct Node {
+        // children[i] is the child for key value base + i.
+        int base;
+        // All children with smaller indices are missing.
+        int min_index;
+        // Number of entries below the node.
+        int size;
+        vector<int> children;
+
+        Node()
+            : base(0), min_index(numeric_limits<int>::max()), size(0) {
+        }
+    };
+
+    // The root is nodes[0]. Empty nodes and buckets are removed and reused.
+    vector<Node> nodes;
+    vector<int> free_nodes;
+    vector<Bucket> buckets;
+    vector<int> free_buckets;
+    map<vector<int>, Bucket> sparse_buckets;
+    int size;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+    // Reused for all insertions and removals to avoid allocations.
+    vector<int> key;
+    vector<int> min_key;
+    vector<int> path;
+
+    int dimension() const;
+    bool is_dense(const vector<int> &key) const;
+    int create_node();
+    int create_bucket();
+    int get_or_create_child(int node_id, int value, bool is_last_level);
+    int find_min_dense_key();
+    Entry remove_min_dense();
+    Entry remove_min_sparse();
+
+protected:
+    virtual void do_insertion(EvaluationContext &eval_context,
+                              const Entry &entry) override;
+
+public:
+    explicit BucketTieBreakingOpenList(const Options &opts);
+    virtual ~BucketTieBreakingOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(set<Evaluator *> &evals) override;
+    virtual bool is_dead_end(
+        EvaluationContext &eval_context) const override;
+    virtual bool is_reliable_dead_end(
+        EvaluationContext &eval_context) const override;
+};
+
+template<class Entry>
+const int BucketTieBreakingOpenList<Entry>::MAX_DENSE_VALUE;
+template<class Entry>
+const int BucketTieBreakingOpenList<Entry>::NO_CHILD;
+
+template<class Entry>
+BucketTieBreakingOpenList<Entry>::BucketTieBreakingOpenList(const Options &opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only")),
+      nodes(1),
+      size(0), evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")),
+      allow_unsafe_pruning(opts.get<bool>("unsafe_pruning")),
+      key(evaluators.size()),
+      min_key(evaluators.size()),
+      path(evaluators.size()) {
+}
+
+template<class Entry>
+bool BucketTieBreakingOpenList<Entry>::is_dense(const vector<int> &key) const {
+    for (int value : key) {
+        if (value < 0 || value >= MAX_DENSE_VALUE)
+            return false;
+    }
+    return true;
+}
+
+template<class Entry>
+int BucketTieBreakingOpenList<Entry>::create_node() {
+    if (free_nodes.empty()) {
+        nodes.emplace_back();
+        return nodes.size() - 1;
+    }
+    int node_id = free_nodes.back();
+    free_nodes.pop_back();
+    return node_id;
+}
+
+template<class Entry>
+int BucketTieBreakingOpenList<Entry>::create_bucket() {
+    if (free_buckets.empty()) {
+        buckets.emplace_back();
+        return buckets.size() - 1;
+    }
+    int bucket_id = free_buckets.back();
+    free_buckets.pop_back();
+    return bucket_id;
+}
+
+template<class Entry>
+int BucketTieBreakingOpenList<Entry>::get_or_create_child(
+    int node_id, int value, bool is_last_level) {
+    Node &node = nodes[node_id];
+    if (node.children.empty()) {
+        node.base = value;
+    } else if (value < node.base) {
+        int shift = node.base - value;
+        node.children.insert(node.children.begin(), shift, NO_CHILD);
+        node.min_index += shift;
+        node.base = value;
+    }
+    int index = value - node.base;
+    if (index >= static_cast<int>(node.children.size()))
+        node.children.resize(index + 1, NO_CHILD);
+    node.min_index = min(node.min_index, index);
+    if (node.children[index] == NO_CHILD) {
+        // Creating a node may invalidate the reference to node.
+        int child = is_last_level ? create_bucket() : create_node();
+        nodes[node_id].children[index] = child;
+    }
+    return nodes[node_id].children[index];
+}
+
+template<class Entry>
+void BucketTieBreakingOpenList<Entry>::do_insertion(
+    EvaluationContext &eval_context, const Entry &entry) {
+    int dim = dimension();
+    for (int i = 0; i < dim; ++i)
+        key[i] = eval_context.get_evaluator_value_or_infinity(evaluators[i].get());
+    ++size;
+
+    if (!is_dense(key)) {
+        sparse_buckets[key].push_back(entry);
+        return;
+    }
+
+    int node_id = 0;
+    for (int i = 0; i < dim; ++i) {
+        int child = get_or_create_child(node_id, key[i], i == dim - 1);
+        ++nodes[node_id].size;
+        node_id = child;
+    }
+    buckets[node_id].push_back(entry);
+}
+
+template<class Entry>
+int BucketTieBreakingOpenList<Entry>::find_min_dense_key() {
+    assert(nodes[0].size > 0);
+    int node_id = 0;
+    for (int i = 0; i < dimension(); ++i) {
+        Node &node = nodes[node_id];
+        while (node.children[node.min_index] == NO_CHILD)
+            ++node.min_index;
+        min_key[i] = node.base + node.min_index;
+        path[i] = node_id;
+        node_id = node.children[node.min_index];
+    }
+    return node_id;
+}
+
+template<class Entry>
+Entry BucketTieBreakingOpenList<Entry>::remove_min_dense() {
+    int bucket_id = find_min_dense_key();
+    Bucket &bucket = buckets[bucket_id];
+    Entry result = bucket.front();
+    bucket.pop_front();
+
+    // Remove empty buckets and nodes bottom-up, but keep the root.
+    bool remove_child = bucket.empty();
+    if (remove_child)
+        free_buckets.push_back(bucket_id);
+    for (int i = dimension() - 1; i >= 0; --i) {
+        Node &node = nodes[path[i]];
+        --node.size;
+        if (remove_child)
+            node.children[node.min_index] = NO_CHILD;
+        remove_child = (node.size == 0);
+        if (remove_child) {
+            node.children.clear();
+            node.min_index = numeric_limits<int>::max();
+            if (i > 0)
+                free_nodes.push_back(path[i]);
+        }
+    }
+    return result;
+}
+
+template<class Entry>
+Entry BucketTieBreakingOpenList<Entry>::remove_min_sparse() {
+    auto it = sparse_buckets.begin();
+    assert(!it->second.empty());
+    Entry result = it->second.front();
+    it->second.pop_front();
+    if (it->second.empty())
+        sparse_buckets.erase(it);
+    return result;
+}
+
+template<class Entry>
+Entry BucketTieBreakingOpenList<Entry>::remove_min() {
+    assert(size > 0);
+    --size;
+    if (sparse_buckets.empty())
+        return remove_min_dense();
+    if (nodes[0].size == 0)
+        return remove_min_sparse();
+    find_min_dense_key();
+    if (min_key < sparse_buckets.begin()->first)
+        return remove_min_dense();
+    else
+        return remove_min_sparse();
+}
+
+template<class Entry>
+bool BucketTieBreakingOpenList<Entry>::empty() const {
+    return size == 0;
+}
+
+template<class Entry>
+void BucketTieBreakingOpenList<Entry>::clear() {
+    nodes.assign(1, Node());
+    free_nodes.clear();
+    buckets.clear();
+    free_buckets.clear();
+    sparse_buckets.clear();
+    size = 0;
+}
+
+template<class Entry>
+int BucketTieBreakingOpenList<Entry>::dimension() const {
+    return evaluators.size();
+}
+
+template<class Entry>
+void BucketTieBreakingOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template<class Entry>
+void BucketTieBreakingOpenList<Entry>::get_batch_evaluators(set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_batch_evaluators(evals);
+}
+
+template<class Entry>
+bool BucketTieBreakingOpenList<Entry>::is_dead_end(
+    EvaluationContext &eval_context) const {
+    // Same as TieBreakingOpenList::is_dead_end.
+    if (is_reliable_dead_end(eval_context))
+        return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template<class Entry>
+bool BucketTieBreakingOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext &eval_context) const {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+BucketTieBreakingOpenListFactory::BucketTieBreakingOpenListFactory(const Options &options)
+    : options(options) {
+}
+
+unique_ptr<StateOpenList>
+BucketTieBreakingOpenListFactory::create_state_open_list() {
+    return utils::make_unique_ptr<BucketTieBreakingOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketTieBreakingOpenListFactory::create_edge_open_list() {
+    return utils::make_unique_ptr<BucketTieBreakingOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Bucket-based tie-breaking open list",
+        "Removes entries in the same order as the tie-breaking open list, "
+        "but stores them in nested arrays of buckets indexed by the "
+        "evaluator values instead of a map from value vectors to buckets. "
+        "Intended for evaluators with small non-negative integer values, "
+        "such as f, h and bounded g values; other values are supported, "
+        "but slower.");
+    parser.add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators", "false");
+    parser.add_option<bool>(
+        "unsafe_pruning",
+        "allow unsafe pruning when the main evaluator regards a state a dead end",
+        "true");
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<shared_ptr<Evaluator>>("evals");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketTieBreakingOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("bucket_tiebreaking", _parse);
+}
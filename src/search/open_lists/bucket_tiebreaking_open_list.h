@@ -0,0 +1,19 @@
+#ifndef OPEN_LISTS_BUCKET_TIEBREAKING_OPEN_LIST_H
+#define OPEN_LISTS_BUCKET_TIEBREAKING_OPEN_LIST_H
+
+#include "../open_list_factory.h"
+#include "../option_parser_util.h"
+
+namespace bucket_tiebreaking_open_list {
+class BucketTieBreakingOpenListFactory : public OpenListFactory {
+    Options options;
+public:
+    explicit BucketTieBreakingOpenListFactory(const Options &options);
+    virtual ~BucketTieBreakingOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+}
+
+#endif
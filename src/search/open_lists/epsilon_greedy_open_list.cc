@@ -55,6 +55,7 @@ public:
     virtual bool is_reliable_dead_end(
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(set<Evaluator *> &evals) override;
     virtual bool empty() const override;
     virtual void clear() override;
 };
@@ -124,6 +125,11 @@ void EpsilonGreedyOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void EpsilonGreedyOpenList<Entry>::get_batch_evaluators(set<Evaluator *> &evals) {
+    evaluator->get_batch_evaluators(evals);
+}
+
 template<class Entry>
 bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
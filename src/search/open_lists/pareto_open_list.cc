@@ -51,6 +51,7 @@ public:
     virtual bool empty() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -197,6 +198,12 @@ void ParetoOpenList<Entry>::get_path_dependent_evaluators(
         evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void ParetoOpenList<Entry>::get_batch_evaluators(set<Evaluator *> &evals) {
+    for (const shared_ptr<Evaluator> &evaluator : evaluators)
+        evaluator->get_batch_evaluators(evals);
+}
+
 template<class Entry>
 bool ParetoOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
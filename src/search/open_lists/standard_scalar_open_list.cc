@@ -36,6 +36,7 @@ public:
     virtual bool empty() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
+    virtual void get_batch_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
         EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -98,6 +99,11 @@ void StandardScalarOpenList<Entry>::get_path_dependent_evaluators(
     evaluator->get_path_dependent_evaluators(evals);
 }
 
+template<class Entry>
+void StandardScalarOpenList<Entry>::get_batch_evaluators(set<Evaluator *> &evals) {
+    evaluator->get_batch_evaluators(evals);
+}
+
 template<class Entry>
 bool StandardScalarOpenList<Entry>::is_dead_end(
     EvaluationContext &eval_context) const {
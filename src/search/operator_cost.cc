@@ -40,6 +40,15 @@ int get_adjusted_action_cost(const OperatorProxy &op, OperatorCost cost_type, bo
         return get_adjusted_action_cost(op.get_cost(state), cost_type, is_unit_cost);
 }
 
+int get_adjusted_action_cost_for_utility(
+    const OperatorProxy &op, OperatorCost cost_type, bool is_unit_cost, int state_utility) {
+    if (op.is_axiom())
+        return 0;
+    else
+        return get_adjusted_action_cost(
+            op.get_cost_for_utility(state_utility), cost_type, is_unit_cost);
+}
+
 void add_cost_type_option_to_parser(OptionParser &parser) {
     vector<string> cost_types;
     vector<string> cost_types_doc;
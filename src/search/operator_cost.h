@@ -14,6 +14,8 @@ enum OperatorCost {NORMAL = 0, ONE = 1, PLUSONE = 2, MAX_OPERATOR_COST};
 int get_adjusted_action_cost(const OperatorProxy &op, OperatorCost cost_type, bool is_unit_cost);
 int get_adjusted_action_cost(const OperatorProxy &op, OperatorCost cost_type, bool is_unit_cost,
 			     const GlobalState& state);
+int get_adjusted_action_cost_for_utility(
+    const OperatorProxy &op, OperatorCost cost_type, bool is_unit_cost, int state_utility);
 void add_cost_type_option_to_parser(options::OptionParser &parser);
 
 #endif
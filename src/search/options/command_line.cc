@@ -122,6 +122,8 @@ static shared_ptr<SearchEngine> parse_cmd_line_aux(
             num_previously_generated_plans = parse_int_arg(arg, args[i]);
             if (num_previously_generated_plans < 0)
                 throw ArgError("argument for --internal-previous-portfolio-plans must be positive");
+        } else if (arg == "--flatten-root-task") {
+            // Handled by the planner before the command line is parsed.
         } else {
             throw ArgError("unknown option " + arg);
         }
@@ -174,6 +176,9 @@ string usage(const string &progname) {
            "--evaluator EVALUATOR_PREDEFINITION\n"
            "    Predefines an evaluator that can afterwards be referenced\n"
            "    by the name that is specified in the definition.\n"
+           "--flatten-root-task\n"
+           "    Copy the operators, axioms and goals of the transformed root task\n"
+           "    into flat arrays before the search starts.\n"
            "--internal-plan-file FILENAME\n"
            "    Plan will be output to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
@@ -2,10 +2,13 @@
 
 #include "pattern_database.h"
 
+#include "../task_proxy.h"
+
 #include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
+#include <unordered_map>
 
 using namespace std;
 
@@ -14,24 +17,94 @@ CanonicalPDBs::CanonicalPDBs(
     const shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets_)
     : max_additive_subsets(max_additive_subsets_) {
     assert(max_additive_subsets);
+    unordered_map<const PatternDatabase *, int> pdb_ids;
+    pattern_offsets.push_back(0);
+    subset_offsets.push_back(0);
+    for (const PDBCollection &subset : *max_additive_subsets) {
+        for (const shared_ptr<PatternDatabase> &pdb : subset) {
+            auto result = pdb_ids.emplace(pdb.get(), pdbs.size());
+            if (result.second) {
+                pdbs.push_back(pdb.get());
+                const Pattern &pattern = pdb->get_pattern();
+                const vector<size_t> &multipliers = pdb->get_hash_multipliers();
+                pattern_variables.insert(
+                    pattern_variables.end(), pattern.begin(), pattern.end());
+                hash_multipliers.insert(
+                    hash_multipliers.end(), multipliers.begin(), multipliers.end());
+                pattern_offsets.push_back(pattern_variables.size());
+            }
+            subset_pdb_ids.push_back(result.first->second);
+        }
+        subset_offsets.push_back(subset_pdb_ids.size());
+    }
+    state_indices.resize(pdbs.size());
+    pdb_values.resize(pdbs.size());
 }
 
-int CanonicalPDBs::get_value(const State &state) const {
+void CanonicalPDBs::compute_state_indices(const State &state) const {
+    const vector<int> &values = state.get_values();
+    const int *variables = pattern_variables.data();
+    const size_t *multipliers = hash_multipliers.data();
+    int num_pdbs = pdbs.size();
+    for (int i = 0; i < num_pdbs; ++i) {
+        size_t index = 0;
+        for (int j = pattern_offsets[i]; j < pattern_offsets[i + 1]; ++j) {
+            index += multipliers[j] * values[variables[j]];
+        }
+        state_indices[i] = index;
+    }
+}
+
+int CanonicalPDBs::compute_max_over_sums() const {
     // If we have an empty collection, then max_additive_subsets = { \emptyset }.
     assert(!max_additive_subsets->empty());
+    /*
+      Every PDB belongs to some subset, so a single dead end makes the
+      whole state a dead end.
+    */
+    for (int h : pdb_values) {
+        if (h == numeric_limits<int>::max())
+            return numeric_limits<int>::max();
+    }
     int max_h = 0;
-    for (const auto &subset : *max_additive_subsets) {
+    int num_subsets = subset_offsets.size() - 1;
+    for (int i = 0; i < num_subsets; ++i) {
         int subset_h = 0;
-        for (const shared_ptr<PatternDatabase> &pdb : subset) {
-            /* Experiments showed that it is faster to recompute the
-               h values than to cache them in an unordered_map. */
-            int h = pdb->get_value(state);
-            if (h == numeric_limits<int>::max())
-                return numeric_limits<int>::max();
-            subset_h += h;
+        for (int j = subset_offsets[i]; j < subset_offsets[i + 1]; ++j) {
+            subset_h += pdb_values[subset_pdb_ids[j]];
         }
         max_h = max(max_h, subset_h);
     }
     return max_h;
 }
+
+int CanonicalPDBs::get_value(const State &state) const {
+    /* Experiments showed that it is faster to recompute the
+       h values than to cache them in an unordered_map. */
+    compute_state_indices(state);
+    int num_pdbs = pdbs.size();
+    for (int i = 0; i < num_pdbs; ++i) {
+        pdb_values[i] = pdbs[i]->get_value_for_index(state_indices[i]);
+    }
+    return compute_max_over_sums();
+}
+
+int CanonicalPDBs::get_value_for_bound(
+    const State &state, int cost_bound, pair<int, int> &valid_bounds) const {
+    compute_state_indices(state);
+    int num_pdbs = pdbs.size();
+    for (int i = 0; i < num_pdbs; ++i) {
+        pdb_values[i] = pdbs[i]->get_value_for_bound(
+            state_indices[i], cost_bound, valid_bounds);
+    }
+    return compute_max_over_sums();
+}
+
+bool CanonicalPDBs::uses_cost_bound() const {
+    for (const PatternDatabase *pdb : pdbs) {
+        if (pdb->uses_cost_bound())
+            return true;
+    }
+    return false;
+}
 }
@@ -3,7 +3,10 @@
 
 #include "types.h"
 
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 
 class State;
 
@@ -11,12 +14,43 @@ namespace pdbs {
 class CanonicalPDBs {
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
 
+    /*
+      Flattened representation of max_additive_subsets for evaluation.
+      Each PDB occurring in a subset is stored once. The pattern variables
+      and hash multipliers of PDB i are at positions
+      [pattern_offsets[i], pattern_offsets[i + 1]) of pattern_variables and
+      hash_multipliers, and the IDs of the PDBs in subset j are at positions
+      [subset_offsets[j], subset_offsets[j + 1]) of subset_pdb_ids.
+    */
+    std::vector<const PatternDatabase *> pdbs;
+    std::vector<int> pattern_offsets;
+    std::vector<int> pattern_variables;
+    std::vector<std::size_t> hash_multipliers;
+    std::vector<int> subset_offsets;
+    std::vector<int> subset_pdb_ids;
+
+    // Buffers for the abstract states and values of all PDBs of a state.
+    mutable std::vector<std::size_t> state_indices;
+    mutable std::vector<int> pdb_values;
+
+    void compute_state_indices(const State &state) const;
+    int compute_max_over_sums() const;
 public:
     explicit CanonicalPDBs(
         const std::shared_ptr<MaxAdditivePDBSubsets> &max_additive_subsets);
     ~CanonicalPDBs() = default;
 
     int get_value(const State &state) const;
+
+    /*
+      Like get_value, but uses PatternDatabase::get_value_for_bound for
+      all PDBs and intersects valid_bounds with their intervals.
+    */
+    int get_value_for_bound(
+        const State &state, int cost_bound,
+        std::pair<int, int> &valid_bounds) const;
+
+    bool uses_cost_bound() const;
 };
 }
 
@@ -1,7 +1,9 @@
 #include "canonical_pdbs_heuristic.h"
 
 #include "dominance_pruning.h"
+#include "pattern_database.h"
 #include "pattern_generator.h"
+#include "pdb_factory.h"
 
 #include "../option_parser.h"
 #include "../plugin.h"
@@ -11,10 +13,44 @@
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <unordered_map>
 
 using namespace std;
 
 namespace pdbs {
+/*
+  Pattern collection generators build PDBs that ignore the cost bound.
+  Replace them by PDBs for the same patterns that store the distances
+  under all bounds, keeping the additive subsets.
+*/
+static shared_ptr<MaxAdditivePDBSubsets> create_bounded_pdbs(
+    const TaskProxy &task_proxy, const MaxAdditivePDBSubsets &max_additive_subsets,
+    int num_threads) {
+    unordered_map<PatternDatabase *, int> pdb_ids;
+    PatternCollection patterns;
+    for (const PDBCollection &subset : max_additive_subsets) {
+        for (const shared_ptr<PatternDatabase> &pdb : subset) {
+            if (pdb_ids.emplace(pdb.get(), patterns.size()).second)
+                patterns.push_back(pdb->get_pattern());
+        }
+    }
+    PDBCollection bounded_pdbs =
+        compute_pdbs(task_proxy, patterns, num_threads, true);
+
+    shared_ptr<MaxAdditivePDBSubsets> result =
+        make_shared<MaxAdditivePDBSubsets>();
+    result->reserve(max_additive_subsets.size());
+    for (const PDBCollection &subset : max_additive_subsets) {
+        PDBCollection bounded_subset;
+        bounded_subset.reserve(subset.size());
+        for (const shared_ptr<PatternDatabase> &pdb : subset) {
+            bounded_subset.push_back(bounded_pdbs[pdb_ids[pdb.get()]]);
+        }
+        result->push_back(move(bounded_subset));
+    }
+    return result;
+}
+
 CanonicalPDBs get_canonical_pdbs_from_options(
     const shared_ptr<AbstractTask> &task, const Options &opts) {
     shared_ptr<PatternCollectionGenerator> pattern_generator =
@@ -33,12 +69,22 @@ CanonicalPDBs get_canonical_pdbs_from_options(
         max_additive_subsets = prune_dominated_subsets(
             *pdbs, *max_additive_subsets, num_variables, max_time_dominance_pruning);
     }
+
+    TaskProxy task_proxy(*task);
+    if (opts.get<bool>("use_cost_bound") &&
+        task_proxy.get_cost_bound() != numeric_limits<int>::max()) {
+        utils::Timer bounded_timer;
+        max_additive_subsets = create_bounded_pdbs(
+            task_proxy, *max_additive_subsets, opts.get<int>("num_threads"));
+        cout << "Bounded PDB construction time: " << bounded_timer << endl;
+    }
     return CanonicalPDBs(max_additive_subsets);
 }
 
 CanonicalPDBsHeuristic::CanonicalPDBsHeuristic(const Options &opts)
     : Heuristic(opts),
-      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)) {
+      canonical_pdbs(get_canonical_pdbs_from_options(task, opts)),
+      use_cost_bound(canonical_pdbs.uses_cost_bound()) {
 }
 
 int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
@@ -46,6 +92,18 @@ int CanonicalPDBsHeuristic::compute_heuristic(const GlobalState &global_state) {
     return compute_heuristic(state);
 }
 
+int CanonicalPDBsHeuristic::compute_heuristic_w_bound(
+    const GlobalState &global_state, int cost_bound) {
+    State state = convert_global_state(global_state);
+    pair<int, int> valid_bounds(
+        numeric_limits<int>::min(), numeric_limits<int>::max());
+    int h = canonical_pdbs.get_value_for_bound(state, cost_bound, valid_bounds);
+    set_valid_bounds(valid_bounds.first, valid_bounds.second);
+    if (h == numeric_limits<int>::max())
+        return DEAD_END;
+    return h;
+}
+
 int CanonicalPDBsHeuristic::compute_heuristic(const State &state) const {
     int h = canonical_pdbs.get_value(state);
     if (h == numeric_limits<int>::max()) {
@@ -64,6 +122,12 @@ void add_canonical_pdbs_options_to_parser(options::OptionParser &parser) {
         "value because there are dominating subsets in the collection.",
         "infinity",
         Bounds("0.0", "infinity"));
+    parser.add_option<bool>(
+        "use_cost_bound",
+        "Use or ignore passed in secondary cost bound. If used, the PDBs "
+        "of the collection are rebuilt to store the abstract goal distances "
+        "under all bounds on the remaining bounded cost.",
+        "true");
 }
 
 static shared_ptr<Heuristic> _parse(OptionParser &parser) {
@@ -89,6 +153,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "systematic(1)");
 
     add_canonical_pdbs_options_to_parser(parser);
+    add_num_threads_option_to_parser(parser);
 
     Heuristic::add_options_to_parser(parser);
 
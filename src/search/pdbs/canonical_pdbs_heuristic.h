@@ -13,9 +13,12 @@ namespace pdbs {
 // Implements the canonical heuristic function.
 class CanonicalPDBsHeuristic : public Heuristic {
     CanonicalPDBs canonical_pdbs;
+    bool use_cost_bound;
 
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
+    virtual int compute_heuristic_w_bound(
+        const GlobalState &global_state, int cost_bound) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
        and change the interface to only use State objects. While we are doing
        this, the following method already allows to get the heuristic value
@@ -25,6 +28,10 @@ protected:
 public:
     explicit CanonicalPDBsHeuristic(const options::Options &opts);
     virtual ~CanonicalPDBsHeuristic() = default;
+
+    virtual bool depends_on_cost_bound() const override {
+        return use_cost_bound;
+    }
 };
 
 void add_canonical_pdbs_options_to_parser(options::OptionParser &parser);
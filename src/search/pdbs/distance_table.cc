@@ -0,0 +1,56 @@
+#include "distance_table.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace pdbs {
+DistanceTable::DistanceTable()
+    : quantum(1),
+      cell_bytes(sizeof(int)) {
+}
+
+DistanceTable::DistanceTable(const vector<int> &distances, int quantum)
+    : quantum(quantum) {
+    assert(quantum >= 1);
+    int max_value = 0;
+    for (int distance : distances) {
+        if (distance != numeric_limits<int>::max())
+            max_value = max(max_value, distance / quantum);
+    }
+
+    // The largest value of each cell type is reserved for dead ends.
+    if (max_value < numeric_limits<uint8_t>::max()) {
+        cell_bytes = 1;
+        fill_cells(distances, quantum, cells8);
+    } else if (max_value < numeric_limits<uint16_t>::max()) {
+        cell_bytes = 2;
+        fill_cells(distances, quantum, cells16);
+    } else {
+        cell_bytes = sizeof(int);
+        fill_cells(distances, quantum, cells32);
+    }
+}
+
+template<typename Cell>
+void DistanceTable::fill_cells(
+    const vector<int> &distances, int quantum, vector<Cell> &cells) {
+    cells.reserve(distances.size());
+    for (int distance : distances) {
+        if (distance == numeric_limits<int>::max())
+            cells.push_back(numeric_limits<Cell>::max());
+        else
+            cells.push_back(static_cast<Cell>(distance / quantum));
+    }
+}
+
+size_t DistanceTable::size() const {
+    if (cell_bytes == 1)
+        return cells8.size();
+    else if (cell_bytes == 2)
+        return cells16.size();
+    else
+        return cells32.size();
+}
+}
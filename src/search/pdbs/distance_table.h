@@ -0,0 +1,68 @@
+#ifndef PDBS_DISTANCE_TABLE_H
+#define PDBS_DISTANCE_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace pdbs {
+/*
+  Goal distances of all abstract states of a PDB, stored in cells of 1, 2
+  or 4 bytes. The table picks the smallest cell type whose largest value
+  is larger than all finite distances and uses that largest value to
+  represent dead ends.
+
+  With a quantum q > 1, the table stores floor(d / q) for distance d and
+  returns floor(d / q) * q. This fits larger distances into small cells
+  at the cost of lower estimates. The estimates remain admissible, but
+  not necessarily consistent.
+
+  PatternDatabase also uses tables for the entries of its per-bound
+  frontiers (with q = 1 for the bounds), which are indexed by entry
+  instead of abstract state.
+*/
+class DistanceTable {
+    int quantum;
+    int cell_bytes;
+    // Only the vector for the chosen cell type is used.
+    std::vector<uint8_t> cells8;
+    std::vector<uint16_t> cells16;
+    std::vector<int> cells32;
+
+    template<typename Cell>
+    static void fill_cells(
+        const std::vector<int> &distances, int quantum, std::vector<Cell> &cells);
+
+    template<typename Cell>
+    int decode(Cell cell) const {
+        if (cell == std::numeric_limits<Cell>::max())
+            return std::numeric_limits<int>::max();
+        return static_cast<int>(cell) * quantum;
+    }
+public:
+    DistanceTable();
+    /*
+      distances contains the distance of each abstract state, with
+      numeric_limits<int>::max() for dead ends.
+    */
+    DistanceTable(const std::vector<int> &distances, int quantum);
+
+    int get(std::size_t state_index) const {
+        if (cell_bytes == 1)
+            return decode(cells8[state_index]);
+        else if (cell_bytes == 2)
+            return decode(cells16[state_index]);
+        else
+            return decode(cells32[state_index]);
+    }
+
+    std::size_t size() const;
+
+    int get_cell_bytes() const {
+        return cell_bytes;
+    }
+};
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef PDBS_INCREMENTAL_CANONICAL_PDBS_H
 #define PDBS_INCREMENTAL_CANONICAL_PDBS_H
 
+#include "canonical_pdbs.h"
 #include "max_additive_pdb_sets.h"
 #include "pattern_collection_information.h"
 #include "types.h"
@@ -16,6 +17,8 @@ class IncrementalCanonicalPDBs {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pattern_databases;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    // Evaluates the collection; rebuilt with max_additive_subsets.
+    std::unique_ptr<CanonicalPDBs> canonical_pdbs;
 
     // A pair of variables is additive if no operator has an effect on both.
     VariableAdditivity are_additive;
@@ -1,5 +1,6 @@
 #include "pattern_collection_generator_genetic.h"
 
+#include "pdb_factory.h"
 #include "validation.h"
 #include "zero_one_pdbs.h"
 
@@ -10,6 +11,7 @@
 #include "../task_utils/causal_graph.h"
 #include "../utils/markup.h"
 #include "../utils/math.h"
+#include "../utils/parallel.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 #include "../utils/timer.h"
@@ -30,6 +32,7 @@ PatternCollectionGeneratorGenetic::PatternCollectionGeneratorGenetic(
       num_episodes(opts.get<int>("num_episodes")),
       mutation_probability(opts.get<double>("mutation_probability")),
       disjoint_patterns(opts.get<bool>("disjoint")),
+      num_threads(opts.get<int>("num_threads")),
       rng(utils::parse_rng_from_options(opts)) {
 }
 
@@ -159,10 +162,12 @@ bool PatternCollectionGeneratorGenetic::mark_used_variables(
 
 void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values) {
     TaskProxy task_proxy(*task);
+    // Pattern collections to evaluate, or nullptr for invalid collections.
+    vector<shared_ptr<PatternCollection>> pattern_collections_to_evaluate;
+    pattern_collections_to_evaluate.reserve(pattern_collections.size());
     for (const auto &collection : pattern_collections) {
         //cout << "evaluate pattern collection " << (i + 1) << " of "
         //     << pattern_collections.size() << endl;
-        double fitness = 0;
         bool pattern_valid = true;
         vector<bool> variables_used(task_proxy.get_variables().size(), false);
         shared_ptr<PatternCollection> pattern_collection = make_shared<PatternCollection>();
@@ -187,21 +192,41 @@ void PatternCollectionGeneratorGenetic::evaluate(vector<double> &fitness_values)
             remove_irrelevant_variables(pattern);
             pattern_collection->push_back(pattern);
         }
-        if (!pattern_valid) {
-            /* Set fitness to a very small value to cover cases in which all
-               patterns are invalid. */
-            fitness = 0.001;
-        } else {
-            /* Generate the pattern collection heuristic and get its fitness
-               value. */
-            ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
-            fitness = zero_one_pdbs.compute_approx_mean_finite_h();
-            // Update the best heuristic found so far.
-            if (fitness > best_fitness) {
-                best_fitness = fitness;
-                cout << "best_fitness = " << best_fitness << endl;
-                best_patterns = pattern_collection;
+        if (!pattern_valid)
+            pattern_collection = nullptr;
+        pattern_collections_to_evaluate.push_back(pattern_collection);
+    }
+
+    /*
+      The PDBs of one collection depend on each other through the cost
+      partitioning, but different collections are independent, so we
+      evaluate them concurrently.
+    */
+    vector<double> new_fitness_values(pattern_collections_to_evaluate.size());
+    utils::parallel_for(
+        pattern_collections_to_evaluate.size(), num_threads,
+        [&](int i) {
+            const shared_ptr<PatternCollection> &pattern_collection =
+                pattern_collections_to_evaluate[i];
+            if (!pattern_collection) {
+                /* Set fitness to a very small value to cover cases in which
+                   all patterns are invalid. */
+                new_fitness_values[i] = 0.001;
+            } else {
+                /* Generate the pattern collection heuristic and get its
+                   fitness value. */
+                ZeroOnePDBs zero_one_pdbs(task_proxy, *pattern_collection);
+                new_fitness_values[i] = zero_one_pdbs.compute_approx_mean_finite_h();
             }
+        });
+
+    // Update the best heuristic found so far in the order of the collections.
+    for (size_t i = 0; i < pattern_collections_to_evaluate.size(); ++i) {
+        double fitness = new_fitness_values[i];
+        if (pattern_collections_to_evaluate[i] && fitness > best_fitness) {
+            best_fitness = fitness;
+            cout << "best_fitness = " << best_fitness << endl;
+            best_patterns = pattern_collections_to_evaluate[i];
         }
         fitness_values.push_back(fitness);
     }
@@ -365,6 +390,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "consider a pattern collection invalid (giving it very low "
         "fitness) if its patterns are not disjoint",
         "false");
+    add_num_threads_option_to_parser(parser);
 
     utils::add_rng_options(parser);
 
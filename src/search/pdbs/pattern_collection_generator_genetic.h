@@ -33,6 +33,8 @@ class PatternCollectionGeneratorGenetic : public PatternCollectionGenerator {
     /* Specifies whether patterns in each pattern collection need to be disjoint
        or not. */
     const bool disjoint_patterns;
+    // Number of threads for evaluating the pattern collections.
+    const int num_threads;
     std::shared_ptr<utils::RandomNumberGenerator> rng;
 
     std::shared_ptr<AbstractTask> task;
@@ -3,6 +3,7 @@
 #include "canonical_pdbs_heuristic.h"
 #include "incremental_canonical_pdbs.h"
 #include "pattern_database.h"
+#include "pdb_factory.h"
 #include "validation.h"
 
 #include "../option_parser.h"
@@ -114,6 +115,7 @@ PatternCollectionGeneratorHillclimbing::PatternCollectionGeneratorHillclimbing(c
       num_samples(opts.get<int>("num_samples")),
       min_improvement(opts.get<int>("min_improvement")),
       max_time(opts.get<double>("max_time")),
+      num_threads(opts.get<int>("num_threads")),
       rng(utils::parse_rng_from_options(opts)),
       num_rejected(0),
       hill_climbing_timer(0) {
@@ -128,6 +130,7 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
     const Pattern &pattern = pdb.get_pattern();
     int pdb_size = pdb.get_size();
     int max_pdb_size = 0;
+    PatternCollection new_patterns;
     for (int pattern_var : pattern) {
         assert(utils::in_bounds(pattern_var, relevant_neighbours));
         const vector<int> &connected_vars = relevant_neighbours[pattern_var];
@@ -151,19 +154,23 @@ int PatternCollectionGeneratorHillclimbing::generate_candidate_pdbs(
                     /*
                       If we haven't seen this pattern before, generate a PDB
                       for it and add it to candidate_pdbs if its size does not
-                      surpass the size limit.
+                      surpass the size limit. The PDBs of all new patterns
+                      are built together below, so they can be built
+                      concurrently.
                     */
                     generated_patterns.insert(new_pattern);
-                    candidate_pdbs.push_back(
-                        make_shared<PatternDatabase>(task_proxy, new_pattern));
-                    max_pdb_size = max(max_pdb_size,
-                                       candidate_pdbs.back()->get_size());
+                    new_patterns.push_back(move(new_pattern));
                 }
             } else {
                 ++num_rejected;
             }
         }
     }
+    for (const shared_ptr<PatternDatabase> &new_pdb :
+         compute_pdbs(task_proxy, new_patterns, num_threads)) {
+        candidate_pdbs.push_back(new_pdb);
+        max_pdb_size = max(max_pdb_size, new_pdb->get_size());
+    }
     return max_pdb_size;
 }
 
@@ -460,6 +467,7 @@ void add_hillclimbing_options(OptionParser &parser) {
         "spent for pruning dominated patterns.",
         "infinity",
         Bounds("0.0", "infinity"));
+    add_num_threads_option_to_parser(parser);
     utils::add_rng_options(parser);
 }
 
@@ -608,6 +616,9 @@ static shared_ptr<Heuristic> _parse_ipdb(OptionParser &parser) {
         "patterns", pgh);
     heuristic_opts.set<double>(
         "max_time_dominance_pruning", opts.get<double>("max_time_dominance_pruning"));
+    heuristic_opts.set<bool>(
+        "use_cost_bound", opts.get<bool>("use_cost_bound"));
+    heuristic_opts.set<int>("num_threads", opts.get<int>("num_threads"));
 
     // Note: in the long run, this should return a shared pointer.
     return make_shared<CanonicalPDBsHeuristic>(heuristic_opts);
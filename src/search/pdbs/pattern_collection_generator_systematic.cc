@@ -1,5 +1,6 @@
 #include "pattern_collection_generator_systematic.h"
 
+#include "pdb_factory.h"
 #include "validation.h"
 
 #include "../option_parser.h"
@@ -47,7 +48,8 @@ static void compute_union_pattern(
 PatternCollectionGeneratorSystematic::PatternCollectionGeneratorSystematic(
     const Options &opts)
     : max_pattern_size(opts.get<int>("pattern_max_size")),
-      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")) {
+      only_interesting_patterns(opts.get<bool>("only_interesting_patterns")),
+      num_threads(opts.get<int>("num_threads")) {
 }
 
 void PatternCollectionGeneratorSystematic::compute_eff_pre_neighbors(
@@ -268,7 +270,7 @@ PatternCollectionInformation PatternCollectionGeneratorSystematic::generate(
     } else {
         build_patterns_naive(task_proxy);
     }
-    return PatternCollectionInformation(task_proxy, patterns);
+    return PatternCollectionInformation(task_proxy, patterns, num_threads);
 }
 
 static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
@@ -295,6 +297,7 @@ static shared_ptr<PatternCollectionGenerator> _parse(OptionParser &parser) {
         "Only consider the union of two disjoint patterns if the union has "
         "more information than the individual patterns.",
         "true");
+    add_num_threads_option_to_parser(parser);
 
     Options opts = parser.parse();
     if (parser.dry_run())
@@ -2,6 +2,7 @@
 
 #include "pattern_database.h"
 #include "max_additive_pdb_sets.h"
+#include "pdb_factory.h"
 #include "validation.h"
 
 #include <algorithm>
@@ -14,11 +15,13 @@ using namespace std;
 namespace pdbs {
 PatternCollectionInformation::PatternCollectionInformation(
     const TaskProxy &task_proxy,
-    const shared_ptr<PatternCollection> &patterns)
+    const shared_ptr<PatternCollection> &patterns,
+    int num_threads)
     : task_proxy(task_proxy),
       patterns(patterns),
       pdbs(nullptr),
-      max_additive_subsets(nullptr) {
+      max_additive_subsets(nullptr),
+      num_threads(num_threads) {
     assert(patterns);
     validate_and_normalize_patterns(task_proxy, *patterns);
 }
@@ -70,12 +73,8 @@ bool PatternCollectionInformation::information_is_valid() const {
 void PatternCollectionInformation::create_pdbs_if_missing() {
     assert(patterns);
     if (!pdbs) {
-        pdbs = make_shared<PDBCollection>();
-        for (const Pattern &pattern : *patterns) {
-            shared_ptr<PatternDatabase> pdb =
-                make_shared<PatternDatabase>(task_proxy, pattern);
-            pdbs->push_back(pdb);
-        }
+        pdbs = make_shared<PDBCollection>(
+            compute_pdbs(task_proxy, *patterns, num_threads));
     }
 }
 
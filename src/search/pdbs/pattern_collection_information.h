@@ -22,6 +22,8 @@ class PatternCollectionInformation {
     std::shared_ptr<PatternCollection> patterns;
     std::shared_ptr<PDBCollection> pdbs;
     std::shared_ptr<MaxAdditivePDBSubsets> max_additive_subsets;
+    // Number of threads for building missing PDBs.
+    int num_threads;
 
     void create_pdbs_if_missing();
     void create_max_additive_subsets_if_missing();
@@ -30,7 +32,8 @@ class PatternCollectionInformation {
 public:
     PatternCollectionInformation(
         const TaskProxy &task_proxy,
-        const std::shared_ptr<PatternCollection> &patterns);
+        const std::shared_ptr<PatternCollection> &patterns,
+        int num_threads = 1);
     ~PatternCollectionInformation() = default;
 
     void set_pdbs(const std::shared_ptr<PDBCollection> &pdbs);
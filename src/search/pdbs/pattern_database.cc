@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <limits>
 #include <string>
@@ -24,8 +25,10 @@ AbstractOperator::AbstractOperator(const vector<FactPair> &prev_pairs,
                                    const vector<FactPair> &pre_pairs,
                                    const vector<FactPair> &eff_pairs,
                                    int cost,
+                                   int bounded_cost,
                                    const vector<size_t> &hash_multipliers)
     : cost(cost),
+      bounded_cost(bounded_cost),
       regression_preconditions(prev_pairs) {
     regression_preconditions.insert(regression_preconditions.end(),
                                     eff_pairs.begin(),
@@ -70,7 +73,9 @@ PatternDatabase::PatternDatabase(
     const TaskProxy &task_proxy,
     const Pattern &pattern,
     bool dump,
-    const vector<int> &operator_costs)
+    const vector<int> &operator_costs,
+    bool use_cost_bound,
+    int distance_quantum)
     : pattern(pattern) {
     task_properties::verify_no_axioms(task_proxy);
     task_properties::verify_no_conditional_effects(task_proxy);
@@ -93,13 +98,22 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs);
-    if (dump)
+    create_pdb(task_proxy, operator_costs, use_cost_bound, distance_quantum);
+    if (dump) {
         cout << "PDB construction time: " << timer << endl;
+        cout << "PDB distance table: " << distances.get_cell_bytes()
+             << " byte(s) per abstract state" << endl;
+        if (uses_cost_bound()) {
+            cout << "PDB frontiers: " << frontier_distances.size()
+                 << " entries of " << frontier_bounds.get_cell_bytes()
+                 << "+" << frontier_distances.get_cell_bytes() << " byte(s)"
+                 << endl;
+        }
+    }
 }
 
 void PatternDatabase::multiply_out(
-    int pos, int cost, vector<FactPair> &prev_pairs,
+    int pos, int cost, int bounded_cost, vector<FactPair> &prev_pairs,
     vector<FactPair> &pre_pairs,
     vector<FactPair> &eff_pairs,
     const vector<FactPair> &effects_without_pre,
@@ -110,7 +124,7 @@ void PatternDatabase::multiply_out(
         if (!eff_pairs.empty()) {
             operators.push_back(
                 AbstractOperator(prev_pairs, pre_pairs, eff_pairs, cost,
-                                 hash_multipliers));
+                                 bounded_cost, hash_multipliers));
         }
     } else {
         // For each possible value for the current variable, build an
@@ -125,8 +139,8 @@ void PatternDatabase::multiply_out(
             } else {
                 prev_pairs.emplace_back(var_id, i);
             }
-            multiply_out(pos + 1, cost, prev_pairs, pre_pairs, eff_pairs,
-                         effects_without_pre, variables, operators);
+            multiply_out(pos + 1, cost, bounded_cost, prev_pairs, pre_pairs,
+                         eff_pairs, effects_without_pre, variables, operators);
             if (i != eff) {
                 pre_pairs.pop_back();
                 eff_pairs.pop_back();
@@ -138,7 +152,7 @@ void PatternDatabase::multiply_out(
 }
 
 void PatternDatabase::build_abstract_operators(
-    const OperatorProxy &op, int cost,
+    const OperatorProxy &op, int cost, int bounded_cost,
     const vector<int> &variable_to_index,
     const VariablesProxy &variables,
     vector<AbstractOperator> &operators) {
@@ -183,12 +197,13 @@ void PatternDatabase::build_abstract_operators(
             }
         }
     }
-    multiply_out(0, cost, prev_pairs, pre_pairs, eff_pairs, effects_without_pre,
-                 variables, operators);
+    multiply_out(0, cost, bounded_cost, prev_pairs, pre_pairs, eff_pairs,
+                 effects_without_pre, variables, operators);
 }
 
 void PatternDatabase::create_pdb(
-    const TaskProxy &task_proxy, const vector<int> &operator_costs) {
+    const TaskProxy &task_proxy, const vector<int> &operator_costs,
+    bool use_cost_bound, int distance_quantum) {
     VariablesProxy variables = task_proxy.get_variables();
     vector<int> variable_to_index(variables.size(), -1);
     for (size_t i = 0; i < pattern.size(); ++i) {
@@ -205,7 +220,8 @@ void PatternDatabase::create_pdb(
             op_cost = operator_costs[op.get_id()];
         }
         build_abstract_operators(
-            op, op_cost, variable_to_index, variables, operators);
+            op, op_cost, op.get_bounded_cost(), variable_to_index, variables,
+            operators);
     }
 
     // build the match tree
@@ -224,78 +240,283 @@ void PatternDatabase::create_pdb(
         }
     }
 
-    distances.reserve(num_states);
+    vector<size_t> goal_states = compute_goal_states(abstract_goals, variables);
+
+    /*
+      Without a finite cost bound, the bounded costs cannot prune any path,
+      so all frontiers would consist of a single entry.
+    */
+    int cost_bound = task_proxy.get_cost_bound();
+    if (use_cost_bound && cost_bound != numeric_limits<int>::max()) {
+        vector<int> bounded_distances =
+            compute_per_bound_distances(
+                match_tree, goal_states, cost_bound, distance_quantum);
+        distances = DistanceTable(bounded_distances, distance_quantum);
+        return;
+    }
+
+    vector<int> goal_distances(num_states, numeric_limits<int>::max());
+    for (size_t state_index : goal_states) {
+        goal_distances[state_index] = 0;
+    }
+
+    int uniform_cost = operators.empty() ? 0 : operators.front().get_cost();
+    bool has_uniform_cost = all_of(
+        operators.begin(), operators.end(),
+        [uniform_cost](const AbstractOperator &op) {
+            return op.get_cost() == uniform_cost;
+        });
+    if (has_uniform_cost) {
+        compute_distances_with_uniform_cost(
+            match_tree, goal_states, uniform_cost, goal_distances);
+    } else {
+        compute_distances(match_tree, goal_states, goal_distances);
+    }
+    distances = DistanceTable(goal_distances, distance_quantum);
+}
+
+void PatternDatabase::compute_distances(
+    const MatchTree &match_tree, const vector<size_t> &goal_states,
+    vector<int> &goal_distances) const {
     // first implicit entry: priority, second entry: index for an abstract state
     priority_queues::AdaptiveQueue<size_t> pq;
-
-    // initialize queue
-    for (size_t state_index = 0; state_index < num_states; ++state_index) {
-        if (is_goal_state(state_index, abstract_goals, variables)) {
-            pq.push(0, state_index);
-            distances.push_back(0);
-        } else {
-            distances.push_back(numeric_limits<int>::max());
-        }
+    for (size_t state_index : goal_states) {
+        pq.push(0, state_index);
     }
 
     // Dijkstra loop
+    vector<const AbstractOperator *> applicable_operators;
     while (!pq.empty()) {
         pair<int, size_t> node = pq.pop();
         int distance = node.first;
         size_t state_index = node.second;
-        if (distance > distances[state_index]) {
+        if (distance > goal_distances[state_index]) {
             continue;
         }
 
         // regress abstract_state
-        vector<const AbstractOperator *> applicable_operators;
+        applicable_operators.clear();
         match_tree.get_applicable_operators(state_index, applicable_operators);
         for (const AbstractOperator *op : applicable_operators) {
             size_t predecessor = state_index + op->get_hash_effect();
-            int alternative_cost = distances[state_index] + op->get_cost();
-            if (alternative_cost < distances[predecessor]) {
-                distances[predecessor] = alternative_cost;
+            int alternative_cost = goal_distances[state_index] + op->get_cost();
+            if (alternative_cost < goal_distances[predecessor]) {
+                goal_distances[predecessor] = alternative_cost;
                 pq.push(alternative_cost, predecessor);
             }
         }
     }
 }
 
-bool PatternDatabase::is_goal_state(
-    const size_t state_index,
+void PatternDatabase::compute_distances_with_uniform_cost(
+    const MatchTree &match_tree, const vector<size_t> &goal_states,
+    int cost, vector<int> &goal_distances) const {
+    /*
+      With the same cost for all operators, the first time a state is
+      reached in a breadth-first search is on a cheapest path, so no
+      priority queue is needed and no state is ever updated twice. We
+      regress layer by layer to only keep the current and the next layer.
+    */
+    vector<size_t> layer(goal_states);
+    vector<size_t> next_layer;
+    vector<const AbstractOperator *> applicable_operators;
+    for (int layer_cost = cost; !layer.empty(); layer_cost += cost) {
+        for (size_t state_index : layer) {
+            applicable_operators.clear();
+            match_tree.get_applicable_operators(state_index, applicable_operators);
+            for (const AbstractOperator *op : applicable_operators) {
+                size_t predecessor = state_index + op->get_hash_effect();
+                if (goal_distances[predecessor] == numeric_limits<int>::max()) {
+                    goal_distances[predecessor] = layer_cost;
+                    next_layer.push_back(predecessor);
+                }
+            }
+        }
+        layer.swap(next_layer);
+        next_layer.clear();
+    }
+}
+
+vector<int> PatternDatabase::compute_per_bound_distances(
+    const MatchTree &match_tree, const vector<size_t> &goal_states,
+    int cost_bound, int distance_quantum) {
+    /*
+      As in merge_and_shrink::Distances, the search is bucket-synchronous
+      over the bounded cost: bucket b holds the (cost, state) pairs reached
+      with bounded cost b as a heap ordered by cost. Each bucket is exhausted
+      (including the entries added by operators with bounded cost 0) before
+      the next one, so every state is settled in lexicographic order of its
+      (bounded cost, cost) pairs and only Pareto-optimal pairs are kept.
+    */
+    using HeapEntry = pair<int, size_t>; // <cost, state>
+    vector<vector<HeapEntry>> buckets(1);
+    for (size_t state_index : goal_states) {
+        buckets[0].emplace_back(0, state_index);
+    }
+
+    // Last (bound, distance) entry of each state, and all entries by state.
+    vector<pair<int, int>> last_entry(num_states, make_pair(-1, -1));
+    vector<pair<size_t, pair<int, int>>> entries;
+
+    vector<const AbstractOperator *> applicable_operators;
+    for (size_t bound = 0; bound < buckets.size(); ++bound) {
+        vector<HeapEntry> heap;
+        heap.swap(buckets[bound]);
+        make_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+            int distance = heap.back().first;
+            size_t state_index = heap.back().second;
+            heap.pop_back();
+
+            pair<int, int> &last = last_entry[state_index];
+            if (last.first != -1 &&
+                (last.first == static_cast<int>(bound) || last.second <= distance))
+                continue;
+            last = make_pair(static_cast<int>(bound), distance);
+            entries.emplace_back(state_index, last);
+
+            applicable_operators.clear();
+            match_tree.get_applicable_operators(state_index, applicable_operators);
+            for (const AbstractOperator *op : applicable_operators) {
+                size_t predecessor = state_index + op->get_hash_effect();
+                int alternative_cost = distance + op->get_cost();
+                int op_bounded_cost = op->get_bounded_cost();
+                if (op_bounded_cost == 0) {
+                    heap.emplace_back(alternative_cost, predecessor);
+                    push_heap(heap.begin(), heap.end(), greater<HeapEntry>());
+                } else if (op_bounded_cost <= cost_bound - static_cast<int>(bound)) {
+                    size_t predecessor_bound = bound + op_bounded_cost;
+                    if (predecessor_bound >= buckets.size())
+                        buckets.resize(predecessor_bound + 1);
+                    buckets[predecessor_bound].emplace_back(
+                        alternative_cost, predecessor);
+                }
+            }
+        }
+    }
+
+    // Pack the entries by state; a stable counting sort keeps their order.
+    frontier_offsets.assign(num_states + 1, 0);
+    for (const auto &entry : entries)
+        ++frontier_offsets[entry.first + 1];
+    for (size_t state_index = 0; state_index < num_states; ++state_index)
+        frontier_offsets[state_index + 1] += frontier_offsets[state_index];
+    vector<int> bounds(entries.size());
+    vector<int> bound_distances(entries.size());
+    vector<int> next_entry(frontier_offsets.begin(), frontier_offsets.end() - 1);
+    for (const auto &entry : entries) {
+        int pos = next_entry[entry.first]++;
+        bounds[pos] = entry.second.first;
+        bound_distances[pos] = entry.second.second;
+    }
+    frontier_bounds = DistanceTable(bounds, 1);
+    frontier_distances = DistanceTable(bound_distances, distance_quantum);
+
+    vector<int> goal_distances(num_states, numeric_limits<int>::max());
+    for (size_t state_index = 0; state_index < num_states; ++state_index) {
+        if (last_entry[state_index].first != -1)
+            goal_distances[state_index] = last_entry[state_index].second;
+    }
+    return goal_distances;
+}
+
+vector<size_t> PatternDatabase::compute_goal_states(
     const vector<FactPair> &abstract_goals,
     const VariablesProxy &variables) const {
+    /*
+      The goal variables have fixed values, so we enumerate the values of
+      the other pattern variables like an odometer, starting with the
+      variable with the smallest multiplier. This yields the goal states
+      in increasing order of their indices.
+    */
+    size_t state_index = 0;
+    vector<bool> is_goal_variable(pattern.size(), false);
     for (const FactPair &abstract_goal : abstract_goals) {
-        int pattern_var_id = abstract_goal.var;
-        int var_id = pattern[pattern_var_id];
-        VariableProxy var = variables[var_id];
-        int temp = state_index / hash_multipliers[pattern_var_id];
-        int val = temp % var.get_domain_size();
-        if (val != abstract_goal.value) {
-            return false;
+        state_index += hash_multipliers[abstract_goal.var] * abstract_goal.value;
+        is_goal_variable[abstract_goal.var] = true;
+    }
+    vector<int> free_variables;
+    vector<int> domain_sizes;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        if (!is_goal_variable[i]) {
+            free_variables.push_back(i);
+            domain_sizes.push_back(variables[pattern[i]].get_domain_size());
+        }
+    }
+
+    vector<size_t> goal_states;
+    vector<int> values(free_variables.size(), 0);
+    while (true) {
+        goal_states.push_back(state_index);
+        size_t pos = 0;
+        for (; pos < free_variables.size(); ++pos) {
+            size_t multiplier = hash_multipliers[free_variables[pos]];
+            if (++values[pos] < domain_sizes[pos]) {
+                state_index += multiplier;
+                break;
+            }
+            state_index -= multiplier * (domain_sizes[pos] - 1);
+            values[pos] = 0;
         }
+        if (pos == free_variables.size())
+            break;
     }
-    return true;
+    return goal_states;
 }
 
 size_t PatternDatabase::hash_index(const State &state) const {
+    const vector<int> &values = state.get_values();
     size_t index = 0;
     for (size_t i = 0; i < pattern.size(); ++i) {
-        index += hash_multipliers[i] * state[pattern[i]].get_value();
+        index += hash_multipliers[i] * values[pattern[i]];
     }
     return index;
 }
 
 int PatternDatabase::get_value(const State &state) const {
-    return distances[hash_index(state)];
+    return get_value_for_index(hash_index(state));
+}
+
+int PatternDatabase::get_value_for_bound(
+    const State &state, int cost_bound, pair<int, int> &valid_bounds) const {
+    return get_value_for_bound(hash_index(state), cost_bound, valid_bounds);
+}
+
+int PatternDatabase::get_value_for_bound(
+    size_t state_index, int cost_bound, pair<int, int> &valid_bounds) const {
+    if (!uses_cost_bound())
+        return distances.get(state_index);
+    int begin = frontier_offsets[state_index];
+    int end = frontier_offsets[state_index + 1];
+    // Binary search for the first entry whose bound exceeds cost_bound.
+    int next = begin;
+    int count = end - begin;
+    while (count > 0) {
+        int step = count / 2;
+        if (frontier_bounds.get(next + step) <= cost_bound) {
+            next += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    if (next != begin)
+        valid_bounds.first = max(valid_bounds.first, frontier_bounds.get(next - 1));
+    if (next != end)
+        valid_bounds.second = min(valid_bounds.second, frontier_bounds.get(next) - 1);
+    if (next == begin)
+        return numeric_limits<int>::max();
+    return frontier_distances.get(next - 1);
 }
 
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
     for (size_t i = 0; i < distances.size(); ++i) {
-        if (distances[i] != numeric_limits<int>::max()) {
-            sum += distances[i];
+        int distance = distances.get(i);
+        if (distance != numeric_limits<int>::max()) {
+            sum += distance;
             ++size;
         }
     }
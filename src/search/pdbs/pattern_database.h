@@ -1,6 +1,7 @@
 #ifndef PDBS_PATTERN_DATABASE_H
 #define PDBS_PATTERN_DATABASE_H
 
+#include "distance_table.h"
 #include "types.h"
 
 #include "../task_proxy.h"
@@ -9,6 +10,8 @@
 #include <vector>
 
 namespace pdbs {
+class MatchTree;
+
 class AbstractOperator {
     /*
       This class represents an abstract operator how it is needed for
@@ -20,6 +23,8 @@ class AbstractOperator {
     */
 
     int cost;
+    // Cost of the operator w.r.t. the cost bound of the task.
+    int bounded_cost;
 
     /*
       Preconditions for the regression search, corresponds to normal
@@ -43,6 +48,7 @@ public:
                      const std::vector<FactPair> &preconditions,
                      const std::vector<FactPair> &effects,
                      int cost,
+                     int bounded_cost,
                      const std::vector<std::size_t> &hash_multipliers);
     ~AbstractOperator();
 
@@ -65,6 +71,7 @@ public:
       the original concrete operator)
     */
     int get_cost() const {return cost;}
+    int get_bounded_cost() const {return bounded_cost;}
     void dump(const Pattern &pattern,
               const VariablesProxy &variables) const;
 };
@@ -80,7 +87,24 @@ class PatternDatabase {
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
     */
-    std::vector<int> distances;
+    DistanceTable distances;
+
+    /*
+      Only computed if the PDB respects the cost bound of the task: the
+      Pareto frontiers of (bound, distance) pairs of all abstract states,
+      as in merge_and_shrink::PerBoundDistances. The entries of state s are
+      at positions [frontier_offsets[s], frontier_offsets[s + 1]) and are
+      sorted by increasing bound and strictly decreasing distance. The
+      distance of s under a bound is the distance of the last entry whose
+      bound does not exceed it (a dead end if there is none). distances
+      holds the distances under the cost bound of the task, i.e., those of
+      the last entries. The bounds (at most the cost bound) and the
+      frontier distances (quantized like the distances) are stored in
+      compact cells as well; only the offsets always take 4 bytes.
+    */
+    std::vector<int> frontier_offsets;
+    DistanceTable frontier_bounds;
+    DistanceTable frontier_distances;
 
     // multipliers for each variable for perfect hash function
     std::vector<std::size_t> hash_multipliers;
@@ -93,7 +117,7 @@ class PatternDatabase {
       abstract operator with a concrete value (!= -1) is computed.
     */
     void multiply_out(
-        int pos, int cost,
+        int pos, int cost, int bounded_cost,
         std::vector<FactPair> &prev_pairs,
         std::vector<FactPair> &pre_pairs,
         std::vector<FactPair> &eff_pairs,
@@ -108,7 +132,7 @@ class PatternDatabase {
       variables in the task to their index in the pattern or -1.
     */
     void build_abstract_operators(
-        const OperatorProxy &op, int cost,
+        const OperatorProxy &op, int cost, int bounded_cost,
         const std::vector<int> &variable_to_index,
         const VariablesProxy &variables,
         std::vector<AbstractOperator> &operators);
@@ -119,19 +143,50 @@ class PatternDatabase {
       all final h-values (stored in distances). operator_costs can
       specify individual operator costs for each operator for action
       cost partitioning. If left empty, default operator costs are used.
+      If use_cost_bound is true and the task has a finite cost bound, the
+      search computes the Pareto frontiers of all abstract states instead.
     */
     void create_pdb(
         const TaskProxy &task_proxy,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs,
+        bool use_cost_bound,
+        int distance_quantum);
+
+    /*
+      Dijkstra regression search from the goal states. goal_distances must
+      be 0 for goal states and numeric_limits<int>::max() otherwise.
+    */
+    void compute_distances(
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states,
+        std::vector<int> &goal_distances) const;
 
     /*
-      For a given abstract state (given as index), the according values
-      for each variable in the state are computed and compared with the
-      given pairs of goal variables and values. Returns true iff the
-      state is a goal state.
+      Breadth-first regression search for the case that all abstract
+      operators have the given cost, with the same contract as
+      compute_distances.
     */
-    bool is_goal_state(
-        std::size_t state_index,
+    void compute_distances_with_uniform_cost(
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states, int cost,
+        std::vector<int> &goal_distances) const;
+
+    /*
+      Regression search over (bounded cost, cost) pairs that ignores paths
+      whose bounded cost exceeds cost_bound. It fills the frontiers and
+      returns the distances under cost_bound.
+    */
+    std::vector<int> compute_per_bound_distances(
+        const MatchTree &match_tree,
+        const std::vector<std::size_t> &goal_states, int cost_bound,
+        int distance_quantum);
+
+    /*
+      Returns the indices of all abstract states that satisfy the given
+      pairs of goal variables (indices into the pattern) and values, in
+      increasing order.
+    */
+    std::vector<std::size_t> compute_goal_states(
         const std::vector<FactPair> &abstract_goals,
         const VariablesProxy &variables) const;
 
@@ -151,16 +206,60 @@ public:
        operator_costs: Can specify individual operator costs for each
        operator. This is useful for action cost partitioning. If left
        empty, default operator costs are used.
+       use_cost_bound: If set to true, the PDB stores the distances of all
+       abstract states under all bounds on the bounded cost up to the
+       cost bound of the task (see get_value_for_bound).
+       distance_quantum: If larger than 1, distances are rounded down to
+       multiples of it to store them in fewer bytes (see DistanceTable).
     */
     PatternDatabase(
         const TaskProxy &task_proxy,
         const Pattern &pattern,
         bool dump = false,
-        const std::vector<int> &operator_costs = std::vector<int>());
+        const std::vector<int> &operator_costs = std::vector<int>(),
+        bool use_cost_bound = false,
+        int distance_quantum = 1);
     ~PatternDatabase() = default;
 
+    // Returns the distance under the cost bound of the task (if used).
     int get_value(const State &state) const;
 
+    /*
+      Returns the distance of the state if at most cost_bound of the
+      bounded cost may be used, or numeric_limits<int>::max() for dead
+      ends. Intersects valid_bounds with the interval of bounds under which
+      the distance is the same. PDBs that do not use the cost bound return
+      get_value(state) and leave valid_bounds unchanged.
+    */
+    int get_value_for_bound(
+        const State &state, int cost_bound,
+        std::pair<int, int> &valid_bounds) const;
+
+    /*
+      The following methods look up abstract states by their index (see
+      get_hash_multipliers), which allows users to compute the indices
+      for many PDBs in one pass over the state.
+    */
+    int get_value_for_index(std::size_t state_index) const {
+        return distances.get(state_index);
+    }
+
+    int get_value_for_bound(
+        std::size_t state_index, int cost_bound,
+        std::pair<int, int> &valid_bounds) const;
+
+    /*
+      The index of the abstract state of a state s is the sum of
+      get_hash_multipliers()[i] * s[get_pattern()[i]] over all i.
+    */
+    const std::vector<std::size_t> &get_hash_multipliers() const {
+        return hash_multipliers;
+    }
+
+    bool uses_cost_bound() const {
+        return !frontier_offsets.empty();
+    }
+
     // Returns the pattern (i.e. all variables used) of the PDB
     const Pattern &get_pattern() const {
         return pattern;
@@ -0,0 +1,37 @@
+#include "pdb_factory.h"
+
+#include "pattern_database.h"
+
+#include "../option_parser.h"
+#include "../task_proxy.h"
+
+#include "../utils/parallel.h"
+
+#include <vector>
+
+using namespace std;
+
+namespace pdbs {
+PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads, bool use_cost_bound) {
+    PDBCollection pdbs(patterns.size());
+    utils::parallel_for(
+        patterns.size(), num_threads,
+        [&](int i) {
+            pdbs[i] = make_shared<PatternDatabase>(
+                task_proxy, patterns[i], false, vector<int>(), use_cost_bound);
+        });
+    return pdbs;
+}
+
+void add_num_threads_option_to_parser(options::OptionParser &parser) {
+    parser.add_option<int>(
+        "num_threads",
+        "number of threads used for building pattern databases. The PDBs of "
+        "different patterns are built concurrently; the resulting heuristic "
+        "does not depend on the number of threads.",
+        "1",
+        Bounds("1", "infinity"));
+}
+}
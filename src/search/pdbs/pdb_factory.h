@@ -0,0 +1,26 @@
+#ifndef PDBS_PDB_FACTORY_H
+#define PDBS_PDB_FACTORY_H
+
+#include "types.h"
+
+class TaskProxy;
+
+namespace options {
+class OptionParser;
+}
+
+namespace pdbs {
+/*
+  Build the PDBs for the given patterns with up to num_threads threads.
+  The PDBs are independent, so the i-th PDB of the result is the PDB of
+  the i-th pattern regardless of the number of threads. Building PDBs
+  concurrently multiplies the peak memory needed for their construction.
+*/
+extern PDBCollection compute_pdbs(
+    const TaskProxy &task_proxy, const PatternCollection &patterns,
+    int num_threads, bool use_cost_bound = false);
+
+extern void add_num_threads_option_to_parser(options::OptionParser &parser);
+}
+
+#endif
@@ -18,7 +18,9 @@ PatternDatabase get_pdb_from_options(const shared_ptr<AbstractTask> &task,
         opts.get<shared_ptr<PatternGenerator>>("pattern");
     Pattern pattern = pattern_generator->generate(task);
     TaskProxy task_proxy(*task);
-    return PatternDatabase(task_proxy, pattern, true);
+    return PatternDatabase(task_proxy, pattern, true, vector<int>(),
+                           opts.get<bool>("use_cost_bound"),
+                           opts.get<int>("distance_quantum"));
 }
 
 PDBHeuristic::PDBHeuristic(const Options &opts)
@@ -31,6 +33,18 @@ int PDBHeuristic::compute_heuristic(const GlobalState &global_state) {
     return compute_heuristic(state);
 }
 
+int PDBHeuristic::compute_heuristic_w_bound(
+    const GlobalState &global_state, int cost_bound) {
+    State state = convert_global_state(global_state);
+    pair<int, int> valid_bounds(
+        numeric_limits<int>::min(), numeric_limits<int>::max());
+    int h = pdb.get_value_for_bound(state, cost_bound, valid_bounds);
+    set_valid_bounds(valid_bounds.first, valid_bounds.second);
+    if (h == numeric_limits<int>::max())
+        return DEAD_END;
+    return h;
+}
+
 int PDBHeuristic::compute_heuristic(const State &state) const {
     int h = pdb.get_value(state);
     if (h == numeric_limits<int>::max())
@@ -44,7 +58,7 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_language_support("conditional effects", "not supported");
     parser.document_language_support("axioms", "not supported");
     parser.document_property("admissible", "yes");
-    parser.document_property("consistent", "yes");
+    parser.document_property("consistent", "yes (for distance_quantum = 1)");
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
 
@@ -52,6 +66,23 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
         "pattern",
         "pattern generation method",
         "greedy()");
+    parser.add_option<bool>(
+        "use_cost_bound",
+        "Use or ignore passed in secondary cost bound. If used, the PDB "
+        "stores the abstract goal distances under all bounds on the "
+        "remaining bounded cost.",
+        "true");
+    parser.add_option<int>(
+        "distance_quantum",
+        "Round the stored distances down to multiples of this value. The "
+        "PDB stores distances (and, with use_cost_bound, the entries of the "
+        "per-bound frontiers) in 1, 2 or 4 bytes, "
+        "depending on the largest stored value, so a quantum larger than 1 "
+        "can reduce its memory at the cost of lower heuristic values. "
+        "With a quantum larger than 1, the heuristic is admissible but not "
+        "necessarily consistent.",
+        "1",
+        Bounds("1", "infinity"));
     Heuristic::add_options_to_parser(parser);
 
     Options opts = parser.parse();
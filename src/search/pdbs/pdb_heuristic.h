@@ -18,6 +18,8 @@ class PDBHeuristic : public Heuristic {
     PatternDatabase pdb;
 protected:
     virtual int compute_heuristic(const GlobalState &global_state) override;
+    virtual int compute_heuristic_w_bound(
+        const GlobalState &global_state, int cost_bound) override;
     /* TODO: we want to get rid of compute_heuristic(const GlobalState &state)
        and change the interface to only use State objects. While we are doing
        this, the following method already allows to get the heuristic value
@@ -35,6 +37,10 @@ public:
     */
     PDBHeuristic(const options::Options &opts);
     virtual ~PDBHeuristic() override = default;
+
+    virtual bool depends_on_cost_bound() const override {
+        return pdb.uses_cost_bound();
+    }
 };
 }
 
@@ -7,6 +7,7 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include "tasks/flattened_task.h"
 #include "tasks/osp_single_end_action_reformulation_task.h"
 #include "tasks/osp_direct_utility_to_cost_task.h"
 
@@ -15,6 +16,14 @@
 using namespace std;
 using utils::ExitCode;
 
+static bool has_flag(int argc, const char **argv, const string &flag) {
+    for (int i = 1; i < argc; ++i) {
+        if (static_cast<string>(argv[i]) == flag)
+            return true;
+    }
+    return false;
+}
+
 int main(int argc, const char **argv) {
     utils::register_event_handlers();
 
@@ -40,6 +49,13 @@ int main(int argc, const char **argv) {
 	    tasks::g_root_task);
 	cout << "Done with OSPDirectUtilityToCostTask conversion [t=" << utils::g_timer << "]" << endl;
 
+	if (has_flag(argc, argv, "--flatten-root-task")) {
+	    cout << "Flattening root task... [t=" << utils::g_timer << "]" << endl;
+	    tasks::g_root_task = std::make_shared<tasks::FlattenedTask>(
+	        tasks::g_root_task);
+	    cout << "Done flattening root task [t=" << utils::g_timer << "]" << endl;
+	}
+
 	std::vector<FactPairUtility> utilities = tasks::g_root_task->get_fact_pair_utilities();
 	std::vector<int> initial_state_values = tasks::g_root_task->get_initial_state_values();
 
@@ -5,6 +5,7 @@
 #include "option_parser.h"
 #include "plugin.h"
 
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/ordered_set.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
@@ -14,9 +15,11 @@
 #include "utils/system.h"
 #include "utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <limits>
+#include <memory>
 
 using namespace std;
 using utils::ExitCode;
@@ -45,9 +48,10 @@ SearchEngine::SearchEngine(const Options &opts)
       solution_found(false),
       task(tasks::g_root_task),
       task_proxy(*task),
-      state_registry(task_proxy),
+      state_registry(task_proxy, create_state_data_pool(opts)),
       successor_generator(get_successor_generator(task_proxy)),
-      search_space(state_registry),
+      search_space(state_registry,
+                   static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       cost_type(static_cast<OperatorCost>(opts.get_enum("cost_type"))),
       is_unit_cost(task_properties::is_unit_cost(task_proxy)),
       max_time(opts.get<double>("max_time")) {
@@ -127,6 +131,11 @@ int SearchEngine::get_adjusted_cost(
   return get_adjusted_action_cost(op, cost_type, is_unit_cost, state);
 }
 
+int SearchEngine::get_adjusted_cost_for_utility(
+    const OperatorProxy &op, int state_utility) const {
+    return get_adjusted_action_cost_for_utility(op, cost_type, is_unit_cost, state_utility);
+}
+
 /* TODO: merge this into add_options_to_parser when all search
          engines support pruning.
 
@@ -156,6 +165,25 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<bool>(
+        "mapped_state_storage",
+        "store the data of registered states in a memory-mapped temporary "
+        "file in the current working directory instead of on the heap, so "
+        "that the operating system can page out states to disk. The hash "
+        "table of registered states and the per-state information of the "
+        "search (g values, parents, ...) stay on the heap. Note that the "
+        "mapped file counts towards limits on the address space "
+        "(ulimit -v), but only its resident part counts towards limits "
+        "on the resident memory (e.g. cgroups).",
+        "false");
+    parser.add_option<int>(
+        "max_resident_state_memory",
+        "approximate limit in MB on the memory-mapped state data that is "
+        "kept in memory. Older state data is written back and dropped from "
+        "memory whenever a new region of the file is used, and is read from "
+        "disk again on access. Only used with mapped_state_storage=true.",
+        "infinity",
+        Bounds("1", "infinity"));
 }
 
 /* Method doesn't belong here because it's only useful for certain derived classes.
@@ -178,6 +206,22 @@ void SearchEngine::add_succ_order_options(OptionParser &parser) {
     utils::add_rng_options(parser);
 }
 
+shared_ptr<mapped_segment_pool::MappedSegmentPool>
+create_state_data_pool(const Options &opts, int num_registries) {
+    if (!opts.get<bool>("mapped_state_storage"))
+        return nullptr;
+    // The file is extended in regions of this size.
+    const size_t region_bytes = 64 * 1024 * 1024;
+    int max_resident_mb = opts.get<int>("max_resident_state_memory");
+    size_t max_resident_bytes = numeric_limits<size_t>::max();
+    if (max_resident_mb != numeric_limits<int>::max()) {
+        max_resident_bytes = static_cast<size_t>(max_resident_mb) * 1024 * 1024 /
+            num_registries;
+    }
+    return make_shared<mapped_segment_pool::MappedSegmentPool>(
+        ".", min(region_bytes, max_resident_bytes), max_resident_bytes);
+}
+
 void print_initial_evaluator_values(const EvaluationContext &eval_context) {
     eval_context.get_cache().for_each_evaluator_result(
         [] (const Evaluator *eval, const EvaluationResult &result) {
@@ -10,8 +10,13 @@
 #include "state_registry.h"
 #include "task_proxy.h"
 
+#include <memory>
 #include <vector>
 
+namespace mapped_segment_pool {
+class MappedSegmentPool;
+}
+
 namespace options {
 class OptionParser;
 class Options;
@@ -56,6 +61,7 @@ protected:
     bool check_goal_and_set_plan(const GlobalState &state);
     int get_adjusted_cost(const OperatorProxy &op) const;
     virtual int get_adjusted_cost(const OperatorProxy &op, const GlobalState &state) const;
+    int get_adjusted_cost_for_utility(const OperatorProxy &op, int state_utility) const;
 public:
     SearchEngine(const options::Options &opts);
     virtual ~SearchEngine();
@@ -80,6 +86,15 @@ public:
 /*
   Print evaluator values of all evaluators evaluated in the evaluation context.
 */
+/*
+  Create the store for the state data of a state registry as configured by
+  the options of the search engine: nullptr for the heap or a memory-mapped
+  pool. Engines with several registries share the resident memory limit
+  among num_registries pools.
+*/
+extern std::shared_ptr<mapped_segment_pool::MappedSegmentPool>
+create_state_data_pool(const options::Options &opts, int num_registries = 1);
+
 extern void print_initial_evaluator_values(const EvaluationContext &eval_context);
 
 extern void collect_preferred_operators(
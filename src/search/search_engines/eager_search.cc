@@ -8,7 +8,10 @@
 
 #include "../algorithms/ordered_set.h"
 #include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/timer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -25,7 +28,12 @@ EagerSearch::EagerSearch(const Options &opts)
       f_evaluator(opts.get<shared_ptr<Evaluator>>("f_eval", nullptr)),
       preferred_operator_evaluators(opts.get_list<shared_ptr<Evaluator>>("preferred")),
       lazy_evaluator(opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr)),
-      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")) {
+      pruning_method(opts.get<shared_ptr<PruningMethod>>("pruning")),
+      anytime(opts.get<bool>("anytime")),
+      best_utility(-1),
+      utility_bound_evaluator(
+          opts.get<shared_ptr<Evaluator>>("utility_bound", nullptr)),
+      num_pruned_by_incumbent(0) {
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
@@ -67,9 +75,28 @@ void EagerSearch::initialize() {
         lazy_evaluator->get_path_dependent_evaluators(evals);
     }
 
+    if (utility_bound_evaluator) {
+        utility_bound_evaluator->get_path_dependent_evaluators(evals);
+    }
+
     path_dependent_evaluators.assign(evals.begin(), evals.end());
 
+    set<Evaluator *> batch_evals;
+    open_list->get_batch_evaluators(batch_evals);
+    if (f_evaluator) {
+        f_evaluator->get_batch_evaluators(batch_evals);
+    }
+    if (utility_bound_evaluator) {
+        utility_bound_evaluator->get_batch_evaluators(batch_evals);
+    }
+    batch_evaluators.assign(batch_evals.begin(), batch_evals.end());
+    if (!batch_evaluators.empty()) {
+        cout << "Evaluating the new successors of each expansion together."
+             << endl;
+    }
+
     const GlobalState &initial_state = state_registry.get_initial_state();
+    search_space.set_state_utility(initial_state, task_proxy.get_state_utility(initial_state));
     for (Evaluator *evaluator : path_dependent_evaluators) {
         evaluator->notify_initial_state(initial_state);
     }
@@ -109,17 +136,32 @@ void EagerSearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
     pruning_method->print_statistics();
+    if (anytime) {
+        cout << "Nodes pruned by incumbent: " << num_pruned_by_incumbent << endl;
+    }
 }
 
 SearchStatus EagerSearch::step() {
     pair<SearchNode, bool> n = fetch_next_node();
     if (!n.second) {
+        if (anytime && found_solution()) {
+            cout << "No plan can improve on utility " << best_utility << endl;
+            return SOLVED;
+        }
         return FAILED;
     }
     SearchNode node = n.first;
 
     GlobalState s = node.get_state();
-    if (check_goal_and_set_plan(s)) {
+    if (anytime) {
+        if (task_properties::is_goal_state(task_proxy, s)) {
+            update_incumbent(s);
+            if (best_utility == task_proxy.get_max_possible_utility()) {
+                cout << "Plan achieves the maximal possible utility." << endl;
+                return SOLVED;
+            }
+        }
+    } else if (check_goal_and_set_plan(s)) {
       return SOLVED;
     }
 
@@ -142,9 +184,17 @@ SearchStatus EagerSearch::step() {
                                     preferred_operators);
     }
 
+    /*
+      Successor utilities are derived from the utility of s, which lets us
+      evaluate utility-dependent operator costs (e.g. the OSP end action)
+      without rescanning the state.
+    */
+    int state_utility = search_space.get_state_utility(s);
+    assert(state_utility == task_proxy.get_state_utility(s));
+
     for (OperatorID op_id : applicable_ops) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        if ((node.get_real_g() + op.get_cost(s)) >= bound)
+        if ((node.get_real_g() + op.get_cost_for_utility(state_utility)) >= bound)
             continue;
 
 	if ((node.get_bounded_g() + op.get_bounded_cost()) > task_proxy.get_cost_bound())
@@ -164,34 +214,32 @@ SearchStatus EagerSearch::step() {
         if (succ_node.is_dead_end())
             continue;
 
+        int adjusted_cost = get_adjusted_cost_for_utility(op, state_utility);
         if (succ_node.is_new()) {
             // We have not seen this state before.
             // Evaluate and create a new node.
+            // Axioms may change utility-relevant facts, so rescan in that case.
+            int succ_utility = task_properties::has_axioms(task_proxy)
+                ? task_proxy.get_state_utility(succ_state)
+                : state_utility + task_properties::get_utility_delta(task_proxy, op, s);
+            search_space.set_state_utility(succ_state, succ_utility);
 
             // Careful: succ_node.get_g() is not available here yet,
             // hence the stupid computation of succ_g.
             // TODO: Make this less fragile.
-            int succ_g = node.get_g() + get_adjusted_cost(op, s);
+            int succ_g = node.get_g() + adjusted_cost;
             int succ_bounded_g = node.get_bounded_g() + op.get_bounded_cost();
-	    
-            EvaluationContext eval_context(
-                succ_state, succ_g, is_preferred, &statistics, false, succ_bounded_g);
-            statistics.inc_evaluated_states();
-
-            if (open_list->is_dead_end(eval_context)) {
-                succ_node.mark_as_dead_end();
-                statistics.inc_dead_ends();
-                continue;
-            }
-            succ_node.open(node, op, get_adjusted_cost(op, s));
 
-            open_list->insert(eval_context, succ_state.get_id());
-            if (search_progress.check_progress(eval_context)) {
-                print_checkpoint_line(succ_node.get_g());
-                reward_progress();
+            if (batch_evaluators.empty()) {
+                EvaluationContext eval_context(
+                    succ_state, succ_g, is_preferred, &statistics, false, succ_bounded_g);
+                open_new_node(node, op_id, adjusted_cost, eval_context);
+            } else {
+                add_pending_successor(
+                    {succ_state, op_id, adjusted_cost, succ_g, succ_bounded_g, is_preferred});
             }
-        } else if ((succ_node.get_g() > node.get_g() + get_adjusted_cost(op, s)) ||
-		   (succ_node.get_g() == node.get_g() + get_adjusted_cost(op, s) &&
+        } else if ((succ_node.get_g() > node.get_g() + adjusted_cost) ||
+		   (succ_node.get_g() == node.get_g() + adjusted_cost &&
 		    (succ_node.get_bounded_g() > node.get_bounded_g() + op.get_bounded_cost()))) {
 
             // We found a new cheapest path to an open or closed state.
@@ -209,12 +257,12 @@ SearchStatus EagerSearch::step() {
 		/*
 		cout << "Reopening node" << endl;
 		cout << "Successor g: " << succ_node.get_g() << ", now generated with g: "
-		     << node.get_g() + get_adjusted_cost(op, s) << endl;
+		     << node.get_g() + adjusted_cost << endl;
 		cout << "Successor bounded g: " << succ_node.get_bounded_g() << ", now generated with bounded g: "
 		     << node.get_bounded_g() + op.get_bounded_cost() << endl;
 		*/
 
-                succ_node.reopen(node, op, get_adjusted_cost(op, s));
+                succ_node.reopen(node, op, adjusted_cost);
 
                 EvaluationContext eval_context(
                     succ_state, succ_node.get_g(), is_preferred, &statistics, false, succ_node.get_bounded_g());
@@ -241,14 +289,87 @@ SearchStatus EagerSearch::step() {
                 // If we do not reopen closed nodes, we just update the parent pointers.
                 // Note that this could cause an incompatibility between
                 // the g-value and the actual path that is traced back.
-                succ_node.update_parent(node, op, get_adjusted_cost(op, s));
+                succ_node.update_parent(node, op, adjusted_cost);
             }
         }
     }
 
+    if (!pending_successors.empty())
+        evaluate_pending_successors(node);
+
     return IN_PROGRESS;
 }
 
+void EagerSearch::add_pending_successor(const PendingSuccessor &successor) {
+    /*
+      The node of a pending successor is still new, so a state reached
+      twice in the same expansion has to be detected here. We keep the
+      cheaper path, as update_parent() would, and treat the state as
+      preferred if any of the paths is preferred. Expansions only have
+      few successors, so a linear search suffices.
+    */
+    for (PendingSuccessor &pending : pending_successors) {
+        if (pending.state.get_id() == successor.state.get_id()) {
+            bool is_preferred = pending.is_preferred || successor.is_preferred;
+            if (successor.g < pending.g ||
+                (successor.g == pending.g && successor.bounded_g < pending.bounded_g)) {
+                pending = successor;
+            }
+            pending.is_preferred = is_preferred;
+            return;
+        }
+    }
+    pending_successors.push_back(successor);
+}
+
+void EagerSearch::evaluate_pending_successors(const SearchNode &parent_node) {
+    vector<EvaluationContext> eval_contexts;
+    eval_contexts.reserve(pending_successors.size());
+    for (const PendingSuccessor &successor : pending_successors) {
+        eval_contexts.emplace_back(
+            successor.state, successor.g, successor.is_preferred, &statistics,
+            false, successor.bounded_g);
+    }
+    vector<EvaluationContext *> eval_context_ptrs;
+    eval_context_ptrs.reserve(eval_contexts.size());
+    for (EvaluationContext &eval_context : eval_contexts) {
+        eval_context_ptrs.push_back(&eval_context);
+    }
+    for (Evaluator *evaluator : batch_evaluators) {
+        evaluator->compute_results(eval_context_ptrs);
+    }
+    for (size_t i = 0; i < pending_successors.size(); ++i) {
+        const PendingSuccessor &successor = pending_successors[i];
+        open_new_node(parent_node, successor.op_id, successor.adjusted_cost,
+                      eval_contexts[i]);
+    }
+    pending_successors.clear();
+}
+
+void EagerSearch::open_new_node(
+    const SearchNode &parent_node, OperatorID op_id, int adjusted_cost,
+    EvaluationContext &eval_context) {
+    const GlobalState &state = eval_context.get_state();
+    statistics.inc_evaluated_states();
+
+    if (is_dominated_by_incumbent(eval_context))
+        return;
+
+    SearchNode node = search_space.get_node(state);
+    if (open_list->is_dead_end(eval_context)) {
+        node.mark_as_dead_end();
+        statistics.inc_dead_ends();
+        return;
+    }
+    node.open(parent_node, task_proxy.get_operators()[op_id], adjusted_cost);
+
+    open_list->insert(eval_context, state.get_id());
+    if (search_progress.check_progress(eval_context)) {
+        print_checkpoint_line(node.get_g());
+        reward_progress();
+    }
+}
+
 pair<SearchNode, bool> EagerSearch::fetch_next_node() {
     /* TODO: The bulk of this code deals with multi-path dependence,
        which is a bit unfortunate since that is a special case that
@@ -277,6 +398,18 @@ pair<SearchNode, bool> EagerSearch::fetch_next_node() {
         if (node.is_closed())
             continue;
 
+        if (anytime && found_solution()) {
+            /*
+              The node may have been inserted before the current incumbent
+              was found. If it cannot lead to a better plan, leave it open
+              so that it is only expanded if it is reached more cheaply.
+            */
+            EvaluationContext eval_context(
+                s, node.get_g(), false, &statistics, false, node.get_bounded_g());
+            if (is_dominated_by_incumbent(eval_context))
+                continue;
+        }
+
         if (!lazy_evaluator)
             assert(!node.is_dead_end());
 
@@ -326,6 +459,53 @@ pair<SearchNode, bool> EagerSearch::fetch_next_node() {
     }
 }
 
+bool EagerSearch::is_dominated_by_incumbent(EvaluationContext &eval_context) {
+    /*
+      With the OSP compilations, a plan of cost c has utility
+      get_max_possible_utility() - c, so the (exclusive) bound set by
+      update_incumbent() is the cost of the best plan found so far. The f
+      evaluator is assumed to be admissible, as it is for A*. The utility
+      bound evaluator estimates the cost of the whole plan (not the
+      cost-to-go), so its value is compared to the bound directly.
+    */
+    if (!anytime || !found_solution() || cost_type != NORMAL)
+        return false;
+    bool dominated;
+    if (f_evaluator) {
+        dominated = eval_context.get_evaluator_value_or_infinity(f_evaluator.get()) >= bound;
+    } else {
+        dominated = eval_context.get_g_value() >= bound;
+    }
+    if (!dominated && utility_bound_evaluator) {
+        dominated = eval_context.get_evaluator_value_or_infinity(
+            utility_bound_evaluator.get()) >= bound;
+    }
+    if (dominated)
+        ++num_pruned_by_incumbent;
+    return dominated;
+}
+
+void EagerSearch::update_incumbent(const GlobalState &goal_state) {
+    int utility = search_space.get_state_utility(goal_state);
+    if (utility <= best_utility)
+        return;
+    cout << "Solution found with utility " << utility
+         << " [t=" << utils::g_timer << "]" << endl;
+    best_utility = utility;
+    Plan plan;
+    search_space.trace_path(goal_state, plan);
+    set_plan(plan);
+    plan_manager.save_plan(plan, task_proxy, true);
+    bound = min(bound, task_proxy.get_max_possible_utility() - utility);
+}
+
+void EagerSearch::save_plan_if_necessary() {
+    // In anytime mode, plans are saved as soon as they are found.
+    if (!anytime) {
+        SearchEngine::save_plan_if_necessary();
+    }
+}
+
 void EagerSearch::reward_progress() {
     // Boost the "preferred operator" open lists somewhat whenever
     // one of the heuristics finds a state with a new best h value.
@@ -356,4 +536,22 @@ void EagerSearch::update_f_value_statistics(const SearchNode &node) {
         statistics.report_f_value_progress(f_value);
     }
 }
+
+void add_options_to_parser(OptionParser &parser) {
+    parser.add_option<bool>(
+        "anytime",
+        "keep searching after the first plan is found and save every plan "
+        "that strictly improves the best utility found so far "
+        "(as sas_plan.1, sas_plan.2, ...). Nodes that cannot lead to a "
+        "better plan according to g (or f_eval, which must then be "
+        "admissible) are pruned. Pruning requires cost_type=NORMAL.",
+        "false");
+    parser.add_option<shared_ptr<Evaluator>>(
+        "utility_bound",
+        "in anytime mode, additionally prune nodes whose value for this "
+        "evaluator is at least the cost of the incumbent plan. The value must "
+        "be a lower bound on get_max_possible_utility() minus the utility of "
+        "any plan through the node, e.g. osp_utility_bound().",
+        OptionParser::NONE);
+}
 }
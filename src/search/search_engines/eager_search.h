@@ -11,6 +11,7 @@ class Evaluator;
 class PruningMethod;
 
 namespace options {
+class OptionParser;
 class Options;
 }
 
@@ -27,7 +28,40 @@ class EagerSearch : public SearchEngine {
 
     std::shared_ptr<PruningMethod> pruning_method;
 
+    /*
+      If some evaluators benefit from evaluating several states at once
+      (see Evaluator::get_batch_evaluators), new successors are not
+      evaluated when they are generated but together at the end of the
+      expansion.
+    */
+    struct PendingSuccessor {
+        GlobalState state;
+        OperatorID op_id;
+        int adjusted_cost;
+        int g;
+        int bounded_g;
+        bool is_preferred;
+    };
+    std::vector<Evaluator *> batch_evaluators;
+    std::vector<PendingSuccessor> pending_successors;
+
+    /*
+      In anytime mode, the search does not stop at the first goal state but
+      saves every plan that strictly improves the best utility found so far
+      and afterwards only considers nodes that can still beat it.
+    */
+    const bool anytime;
+    int best_utility;
+    std::shared_ptr<Evaluator> utility_bound_evaluator;
+    int num_pruned_by_incumbent;
+
     std::pair<SearchNode, bool> fetch_next_node();
+    void add_pending_successor(const PendingSuccessor &successor);
+    void evaluate_pending_successors(const SearchNode &parent_node);
+    void open_new_node(const SearchNode &parent_node, OperatorID op_id,
+                       int adjusted_cost, EvaluationContext &eval_context);
+    bool is_dominated_by_incumbent(EvaluationContext &eval_context);
+    void update_incumbent(const GlobalState &goal_state);
     void start_f_value_statistics(EvaluationContext &eval_context);
     void update_f_value_statistics(const SearchNode &node);
     void reward_progress();
@@ -42,9 +76,12 @@ public:
     virtual ~EagerSearch() = default;
 
     virtual void print_statistics() const override;
+    virtual void save_plan_if_necessary() override;
 
     void dump_search_space() const;
 };
+
+extern void add_options_to_parser(options::OptionParser &parser);
 }
 
 #endif
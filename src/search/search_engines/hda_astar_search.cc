@@ -0,0 +1,497 @@
+#include "hda_astar_search.h"
+
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../plugin.h"
+
+#include "../options/predefinitions.h"
+
+#include "../algorithms/mpsc_queue.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../utils/countdown_timer.h"
+#include "../utils/hash.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_astar_search {
+/*
+  A message describes a path to a state: the g values and the utility of
+  the state reached, and the parent state in the registry of the sending
+  worker together with the operator that was applied.
+*/
+struct MessageHeader {
+    int g;
+    int bounded_g;
+    int utility;
+    int parent_worker;
+    StateID parent_state_id;
+    int creating_operator;
+
+    MessageHeader(int g, int bounded_g, int utility, int parent_worker,
+                  StateID parent_state_id, int creating_operator)
+        : g(g), bounded_g(bounded_g), utility(utility),
+          parent_worker(parent_worker), parent_state_id(parent_state_id),
+          creating_operator(creating_operator) {
+    }
+};
+
+// The packed state of message i is states[i * bins_per_state...].
+struct MessageBatch {
+    vector<MessageHeader> headers;
+    vector<PackedStateBin> states;
+};
+
+struct NodeInfo {
+    int g;
+    int bounded_g;
+    int utility;
+    int parent_worker;
+    StateID parent_state_id;
+    int creating_operator;
+    bool closed;
+    bool dead_end;
+
+    NodeInfo()
+        : g(-1), bounded_g(-1), utility(0), parent_worker(-1),
+          parent_state_id(StateID::no_state), creating_operator(-1),
+          closed(false), dead_end(false) {
+    }
+};
+
+struct OpenEntry {
+    int f;
+    int h;
+    int insertion_order;
+    int g;
+    int bounded_g;
+    StateID id;
+
+    OpenEntry(int f, int h, int insertion_order, int g, int bounded_g, StateID id)
+        : f(f), h(h), insertion_order(insertion_order), g(g),
+          bounded_g(bounded_g), id(id) {
+    }
+
+    // Heap order: minimal f, then minimal h, then FIFO.
+    bool operator<(const OpenEntry &other) const {
+        if (f != other.f)
+            return f > other.f;
+        if (h != other.h)
+            return h > other.h;
+        return insertion_order > other.insertion_order;
+    }
+};
+
+class Worker {
+    HDAStarSearch &engine;
+    const int id;
+    const int bins_per_state;
+
+    StateRegistry state_registry;
+    PerStateInformation<NodeInfo> node_infos;
+    shared_ptr<Evaluator> evaluator;
+    SearchStatistics statistics;
+
+    vector<OpenEntry> open_list;
+    int num_insertions;
+
+    mpsc_queue::MPSCQueue<MessageBatch> inbox;
+    vector<MessageBatch> outboxes;
+    vector<PackedStateBin> successor_buffer;
+    bool idle;
+
+    void receive(const MessageHeader &header, const PackedStateBin *buffer);
+    bool receive_messages();
+    void send(int owner, const MessageHeader &header);
+    void flush(int owner);
+    bool has_open_node_below_incumbent();
+    void expand();
+public:
+    Worker(HDAStarSearch &engine, int id, const shared_ptr<Evaluator> &evaluator,
+           const shared_ptr<mapped_segment_pool::MappedSegmentPool> &state_data_pool);
+
+    // Only called before the worker threads are started.
+    void receive_initial_state(const PackedStateBin *buffer);
+    void run(double max_time);
+
+    const NodeInfo &get_node_info(StateID state_id) {
+        return node_infos[state_registry.lookup_state(state_id)];
+    }
+
+    const SearchStatistics &get_statistics() const {
+        return statistics;
+    }
+
+    int get_num_registered_states() const {
+        return state_registry.size();
+    }
+};
+
+
+Worker::Worker(HDAStarSearch &engine, int id, const shared_ptr<Evaluator> &evaluator,
+               const shared_ptr<mapped_segment_pool::MappedSegmentPool> &state_data_pool)
+    : engine(engine),
+      id(id),
+      bins_per_state(engine.state_registry.get_bins_per_state()),
+      state_registry(engine.task_proxy, state_data_pool),
+      evaluator(evaluator),
+      num_insertions(0),
+      outboxes(engine.num_threads),
+      successor_buffer(bins_per_state),
+      idle(false) {
+    /*
+      A state is evaluated by the worker that owns it, but its parent lives
+      in the registry of the sender, so path-dependent evaluators could not
+      be notified about the transition.
+    */
+    set<Evaluator *> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "hda_astar does not support path-dependent evaluators." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+}
+
+void Worker::receive_initial_state(const PackedStateBin *buffer) {
+    MessageHeader header(0, 0, 0, -1, StateID::no_state, -1);
+    GlobalState initial_state = state_registry.register_state(buffer);
+    header.utility = engine.task_proxy.get_state_utility(initial_state);
+    receive(header, buffer);
+}
+
+void Worker::receive(const MessageHeader &header, const PackedStateBin *buffer) {
+    GlobalState state = state_registry.register_state(buffer);
+    NodeInfo &info = node_infos[state];
+    if (info.dead_end)
+        return;
+    if (info.g != -1) {
+        bool is_better = header.g < info.g ||
+            (header.g == info.g && header.bounded_g < info.bounded_g);
+        if (!is_better)
+            return;
+        if (info.closed)
+            statistics.inc_reopened();
+    }
+    info.g = header.g;
+    info.bounded_g = header.bounded_g;
+    info.utility = header.utility;
+    info.parent_worker = header.parent_worker;
+    info.parent_state_id = header.parent_state_id;
+    info.creating_operator = header.creating_operator;
+    info.closed = false;
+
+    EvaluationContext eval_context(
+        state, info.g, false, &statistics, false, info.bounded_g);
+    statistics.inc_evaluated_states();
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        info.dead_end = true;
+        statistics.inc_dead_ends();
+        return;
+    }
+    int h = eval_context.get_evaluator_value(evaluator.get());
+    int f = info.g + h;
+    if (f >= engine.incumbent_cost.load(memory_order_relaxed))
+        return;
+    open_list.emplace_back(f, h, num_insertions++, info.g, info.bounded_g, state.get_id());
+    push_heap(open_list.begin(), open_list.end());
+}
+
+bool Worker::receive_messages() {
+    bool received = false;
+    MessageBatch batch;
+    while (inbox.try_pop(batch)) {
+        received = true;
+        if (idle) {
+            // Count this worker as busy before releasing the messages.
+            engine.pending_work.fetch_add(1);
+            idle = false;
+        }
+        int num_messages = batch.headers.size();
+        for (int i = 0; i < num_messages; ++i)
+            receive(batch.headers[i], &batch.states[i * bins_per_state]);
+        engine.pending_work.fetch_sub(num_messages);
+    }
+    return received;
+}
+
+void Worker::send(int owner, const MessageHeader &header) {
+    MessageBatch &batch = outboxes[owner];
+    batch.headers.push_back(header);
+    batch.states.insert(batch.states.end(),
+                        successor_buffer.begin(), successor_buffer.end());
+    engine.pending_work.fetch_add(1, memory_order_relaxed);
+    if (static_cast<int>(batch.headers.size()) >= engine.batch_size)
+        flush(owner);
+}
+
+void Worker::flush(int owner) {
+    MessageBatch &batch = outboxes[owner];
+    if (batch.headers.empty())
+        return;
+    engine.workers[owner]->inbox.push(move(batch));
+    batch = MessageBatch();
+}
+
+bool Worker::has_open_node_below_incumbent() {
+    if (open_list.empty())
+        return false;
+    if (open_list.front().f < engine.incumbent_cost.load(memory_order_relaxed))
+        return true;
+    // The minimum is too expensive, so no node can lead to a cheaper plan.
+    open_list.clear();
+    return false;
+}
+
+void Worker::expand() {
+    pop_heap(open_list.begin(), open_list.end());
+    OpenEntry entry = open_list.back();
+    open_list.pop_back();
+
+    GlobalState state = state_registry.lookup_state(entry.id);
+    NodeInfo &info = node_infos[state];
+    if (info.closed || info.g != entry.g || info.bounded_g != entry.bounded_g)
+        return;
+    info.closed = true;
+    statistics.inc_expanded();
+
+    const TaskProxy &task_proxy = engine.task_proxy;
+    if (task_properties::is_goal_state(task_proxy, state)) {
+        // Since entry.f < incumbent_cost, this is a cheaper plan.
+        engine.report_goal(id, entry.id, info.g);
+        return;
+    }
+
+    vector<OperatorID> applicable_ops;
+    engine.successor_generator.generate_applicable_ops(state, applicable_ops);
+    statistics.inc_generated_ops(applicable_ops.size());
+
+    int g = info.g;
+    int bounded_g = info.bounded_g;
+    int utility = info.utility;
+    int cost_bound = task_proxy.get_cost_bound();
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        int succ_g = g + engine.get_adjusted_cost_for_utility(op, utility);
+        if (succ_g >= engine.incumbent_cost.load(memory_order_relaxed))
+            continue;
+        int succ_bounded_g = bounded_g + op.get_bounded_cost();
+        if (succ_bounded_g > cost_bound)
+            continue;
+
+        state_registry.compute_successor_state(state, op, successor_buffer.data());
+        statistics.inc_generated();
+        int succ_utility = utility + task_properties::get_utility_delta(task_proxy, op, state);
+        MessageHeader header(succ_g, succ_bounded_g, succ_utility, id,
+                             entry.id, op_id.get_index());
+        int owner = engine.get_owner(successor_buffer.data());
+        if (owner == id)
+            receive(header, successor_buffer.data());
+        else
+            send(owner, header);
+    }
+}
+
+void Worker::run(double max_time) {
+    utils::CountdownTimer timer(max_time);
+    int iteration = 0;
+    while (!engine.timed_out.load(memory_order_relaxed)) {
+        receive_messages();
+        if (has_open_node_below_incumbent()) {
+            expand();
+        } else {
+            for (int owner = 0; owner < engine.num_threads; ++owner)
+                flush(owner);
+            if (!idle) {
+                idle = true;
+                engine.pending_work.fetch_sub(1);
+            }
+            if (engine.pending_work.load() == 0)
+                break;
+            this_thread::yield();
+        }
+        if (++iteration % 1000 == 0 && timer.is_expired())
+            engine.timed_out = true;
+    }
+}
+
+
+HDAStarSearch::HDAStarSearch(const Options &opts, options::Registry &registry)
+    : SearchEngine(opts),
+      eval_config(opts.get<ParseTree>("eval")),
+      registry(registry),
+      num_threads(opts.get<int>("num_threads")),
+      batch_size(opts.get<int>("batch_size")),
+      incumbent_cost(bound),
+      goal_worker(-1),
+      goal_state_id(StateID::no_state),
+      pending_work(0),
+      timed_out(false) {
+    if (task_properties::has_axioms(task_proxy)) {
+        cerr << "hda_astar does not support axioms." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+    /*
+      Each worker gets its own evaluator instance. They are created here,
+      sequentially, since evaluator construction may use shared
+      (per-task) caches. Predefined evaluators are not available, since
+      their instances would be shared by all workers.
+    */
+    workers.reserve(num_threads);
+    options::Predefinitions no_predefinitions;
+    for (int i = 0; i < num_threads; ++i) {
+        OptionParser parser(eval_config, this->registry, no_predefinitions, false);
+        shared_ptr<Evaluator> evaluator = parser.start_parsing<shared_ptr<Evaluator>>();
+        workers.push_back(utils::make_unique_ptr<Worker>(
+                              *this, i, evaluator,
+                              create_state_data_pool(opts, num_threads)));
+    }
+}
+
+HDAStarSearch::~HDAStarSearch() {
+}
+
+int HDAStarSearch::get_owner(const PackedStateBin *buffer) const {
+    utils::HashState hash_state;
+    int bins_per_state = state_registry.get_bins_per_state();
+    for (int i = 0; i < bins_per_state; ++i)
+        hash_state.feed(buffer[i]);
+    return hash_state.get_hash64() % num_threads;
+}
+
+void HDAStarSearch::report_goal(int worker_id, StateID state_id, int g) {
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (g < incumbent_cost.load()) {
+        cout << "Solution found with cost " << g << " by worker " << worker_id
+             << " [t=" << utils::g_timer << "]" << endl;
+        incumbent_cost = g;
+        goal_worker = worker_id;
+        goal_state_id = state_id;
+    }
+}
+
+void HDAStarSearch::extract_plan() {
+    Plan plan;
+    int worker_id = goal_worker;
+    StateID state_id = goal_state_id;
+    while (true) {
+        const NodeInfo &info = workers[worker_id]->get_node_info(state_id);
+        if (info.creating_operator == -1)
+            break;
+        plan.push_back(OperatorID(info.creating_operator));
+        worker_id = info.parent_worker;
+        state_id = info.parent_state_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+void HDAStarSearch::initialize() {
+    cout << "Conducting hash-distributed A* with " << num_threads
+         << " threads, (real) bound = " << bound << endl;
+    vector<PackedStateBin> buffer(state_registry.get_bins_per_state());
+    state_registry.copy_state(state_registry.get_initial_state(), buffer.data());
+    workers[get_owner(buffer.data())]->receive_initial_state(buffer.data());
+}
+
+SearchStatus HDAStarSearch::step() {
+    pending_work = num_threads;
+    vector<thread> threads;
+    threads.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        Worker *worker = workers[i].get();
+        threads.emplace_back([worker, this]() {worker->run(max_time);});
+    }
+    for (thread &t : threads)
+        t.join();
+
+    for (const unique_ptr<Worker> &worker : workers) {
+        const SearchStatistics &worker_statistics = worker->get_statistics();
+        statistics.inc_expanded(worker_statistics.get_expanded());
+        statistics.inc_evaluated_states(worker_statistics.get_evaluated_states());
+        statistics.inc_evaluations(worker_statistics.get_evaluations());
+        statistics.inc_generated(worker_statistics.get_generated());
+        statistics.inc_reopened(worker_statistics.get_reopened());
+        statistics.inc_generated_ops(worker_statistics.get_generated_ops());
+    }
+
+    if (timed_out)
+        return TIMEOUT;
+    if (goal_worker == -1) {
+        cout << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    extract_plan();
+    return SOLVED;
+}
+
+void HDAStarSearch::print_statistics() const {
+    statistics.print_detailed_statistics();
+    for (int i = 0; i < num_threads; ++i) {
+        cout << "Worker " << i << ": expanded "
+             << workers[i]->get_statistics().get_expanded()
+             << " state(s), registered "
+             << workers[i]->get_num_registered_states() << " state(s)" << endl;
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Hash-distributed A* search",
+        "Parallel A* in which every thread owns a hash partition of the "
+        "state space with its own state registry, open list and evaluator "
+        "instance. Successors are sent to the thread that owns them "
+        "through lock-free queues. For admissible evaluators, the plan is "
+        "optimal. Ties between nodes with the same f value are broken by h "
+        "and then in FIFO order within each thread.");
+    parser.document_note(
+        "Evaluator instances",
+        "The evaluator specification is parsed once per thread, so expensive "
+        "precomputations (e.g., of merge-and-shrink) are repeated per thread. "
+        "Evaluators predefined with --evaluator cannot be used, since all "
+        "threads would share the same instance.");
+    parser.document_note(
+        "Supported tasks",
+        "Tasks with axioms and path-dependent evaluators (e.g., lmcount) "
+        "are not supported.");
+    parser.add_option<ParseTree>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "num_threads",
+        "number of worker threads",
+        "1",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "batch_size",
+        "number of states that are buffered for another thread before they "
+        "are sent to it",
+        "64",
+        Bounds("1", "infinity"));
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        // OptionParser only stores a reference to the predefinitions.
+        options::Predefinitions no_predefinitions;
+        OptionParser test_parser(opts.get<ParseTree>("eval"), parser.get_registry(),
+                                 no_predefinitions, true);
+        test_parser.start_parsing<shared_ptr<Evaluator>>();
+        return nullptr;
+    } else {
+        return make_shared<HDAStarSearch>(opts, parser.get_registry());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("hda_astar", _parse);
+}
@@ -0,0 +1,79 @@
+#ifndef SEARCH_ENGINES_HDA_ASTAR_SEARCH_H
+#define SEARCH_ENGINES_HDA_ASTAR_SEARCH_H
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include "../options/registries.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace options {
+class Options;
+}
+
+namespace hda_astar_search {
+class Worker;
+
+/*
+  Hash-distributed A* (Kishimoto, Fukunaga and Botea, 2009).
+
+  Every worker thread owns the states whose hash value maps to it. It has
+  its own state registry, open list and evaluator instance. Successors of
+  expanded states are sent to their owners through lock-free queues, in
+  batches. The owner detects duplicates, evaluates new states and inserts
+  them into its open list.
+
+  The search keeps the shared cost of the best plan found so far
+  (initially the bound) and prunes all nodes whose f value is not
+  smaller. It terminates when no worker has a node left below that cost
+  and no message is in transit, so the plan is optimal for admissible
+  evaluators. As in eager search, successors whose bounded g value
+  exceeds the secondary cost bound are not generated. A known node is
+  updated if it is reached with a smaller g value, or with the same g
+  value and a smaller bounded g value.
+*/
+class HDAStarSearch : public SearchEngine {
+    friend class Worker;
+
+    const options::ParseTree eval_config;
+    // Copy, since the registry referenced in the constructor does not live long enough.
+    options::Registry registry;
+    const int num_threads;
+    const int batch_size;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Cost of the best plan found so far; nodes with f >= incumbent_cost are pruned.
+    std::atomic<int> incumbent_cost;
+    std::mutex incumbent_mutex;
+    int goal_worker;
+    StateID goal_state_id;
+
+    /*
+      Number of workers that have work plus number of messages in transit.
+      The search space is exhausted when it drops to zero.
+    */
+    std::atomic<long long> pending_work;
+    std::atomic<bool> timed_out;
+
+    int get_owner(const PackedStateBin *buffer) const;
+    void report_goal(int worker_id, StateID state_id, int g);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    HDAStarSearch(const options::Options &opts, options::Registry &registry);
+    virtual ~HDAStarSearch() override;
+
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
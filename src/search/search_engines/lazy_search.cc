@@ -29,7 +29,9 @@ LazySearch::LazySearch(const Options &opts)
       current_operator_id(OperatorID::no_operator),
       current_g(0),
       current_real_g(0),
-      current_eval_context(current_state, 0, true, &statistics) {
+      current_bounded_g(0),
+      current_utility(task_proxy.get_state_utility(current_state)),
+      current_eval_context(current_state, 0, true, &statistics, false, 0) {
     /*
       We initialize current_eval_context in such a way that the initial node
       counts as "preferred".
@@ -42,7 +44,8 @@ void LazySearch::set_preferred_operator_evaluators(
 }
 
 void LazySearch::initialize() {
-    cout << "Conducting lazy best first search, (real) bound = " << bound << endl;
+    cout << "Conducting lazy best first search, (real) bound = " << bound
+         << ", cost bound = " << task_proxy.get_cost_bound() << endl;
 
     assert(open_list);
     set<Evaluator *> evals;
@@ -101,37 +104,66 @@ void LazySearch::generate_successors() {
 
     statistics.inc_generated(successor_operators.size());
 
+    int cost_bound = task_proxy.get_cost_bound();
     for (OperatorID op_id : successor_operators) {
         OperatorProxy op = task_proxy.get_operators()[op_id];
-        int new_g = current_g + get_adjusted_cost(op);
-        int new_real_g = current_real_g + op.get_cost();
+        int new_g = current_g + get_adjusted_cost_for_utility(op, current_utility);
+        int new_real_g = current_real_g + op.get_cost_for_utility(current_utility);
+        int new_bounded_g = current_bounded_g + op.get_bounded_cost();
         bool is_preferred = preferred_operators.contains(op_id);
-        if (new_real_g < bound) {
+        if (new_real_g < bound && new_bounded_g <= cost_bound) {
+            /*
+              The edge is ordered by the heuristic values of current_state,
+              but g and the bounded g belong to the successor.
+            */
             EvaluationContext new_eval_context(
-                current_eval_context.get_cache(), new_g, is_preferred, nullptr);
+                current_eval_context.get_cache(), new_g, is_preferred, nullptr,
+                false, new_bounded_g);
             open_list->insert(new_eval_context, make_pair(current_state.get_id(), op_id));
         }
     }
 }
 
 SearchStatus LazySearch::fetch_next_state() {
-    if (open_list->empty()) {
-        cout << "Completely explored state space -- no solution!" << endl;
-        return FAILED;
-    }
+    while (true) {
+        if (open_list->empty()) {
+            cout << "Completely explored state space -- no solution!" << endl;
+            return FAILED;
+        }
 
-    EdgeOpenListEntry next = open_list->remove_min();
+        EdgeOpenListEntry next = open_list->remove_min();
+
+        current_predecessor_id = next.first;
+        current_operator_id = next.second;
+        /*
+          The bound is also checked when the edge is inserted, but the
+          predecessor may have been reopened since then with a smaller g
+          and a larger bounded g. As in eager search, drop such edges.
+        */
+        SearchNode pred_node = search_space.get_node(
+            state_registry.lookup_state(current_predecessor_id));
+        OperatorProxy op = task_proxy.get_operators()[current_operator_id];
+        current_bounded_g = pred_node.get_bounded_g() + op.get_bounded_cost();
+        if (current_bounded_g <= task_proxy.get_cost_bound())
+            break;
+    }
 
-    current_predecessor_id = next.first;
-    current_operator_id = next.second;
     GlobalState current_predecessor = state_registry.lookup_state(current_predecessor_id);
     OperatorProxy current_operator = task_proxy.get_operators()[current_operator_id];
     assert(task_properties::is_applicable(current_operator, current_predecessor.unpack()));
     current_state = state_registry.get_successor_state(current_predecessor, current_operator);
 
     SearchNode pred_node = search_space.get_node(current_predecessor);
-    current_g = pred_node.get_g() + get_adjusted_cost(current_operator);
-    current_real_g = pred_node.get_real_g() + current_operator.get_cost();
+    int pred_utility = search_space.get_state_utility(current_predecessor);
+    current_g = pred_node.get_g() +
+        get_adjusted_cost_for_utility(current_operator, pred_utility);
+    current_real_g = pred_node.get_real_g() +
+        current_operator.get_cost_for_utility(pred_utility);
+    // Axioms may change utility-relevant facts, so rescan in that case.
+    current_utility = task_properties::has_axioms(task_proxy)
+        ? task_proxy.get_state_utility(current_state)
+        : pred_utility + task_properties::get_utility_delta(
+            task_proxy, current_operator, current_predecessor);
 
     /*
       Note: We mark the node in current_eval_context as "preferred"
@@ -141,11 +173,21 @@ SearchStatus LazySearch::fetch_next_state() {
       associate with the expanded vs. evaluated nodes in lazy search
       and where to obtain it from.
     */
-    current_eval_context = EvaluationContext(current_state, current_g, true, &statistics);
+    current_eval_context = EvaluationContext(
+        current_state, current_g, true, &statistics, false, current_bounded_g);
 
     return IN_PROGRESS;
 }
 
+bool LazySearch::is_cheaper_path(const SearchNode &node) const {
+    /*
+      As in eager search, a path with the same g but a smaller bounded g
+      is better, since it leaves more of the cost bound to its successors.
+    */
+    return current_g < node.get_g() ||
+           (current_g == node.get_g() && current_bounded_g < node.get_bounded_g());
+}
+
 SearchStatus LazySearch::step() {
     // Invariants:
     // - current_state is the next state for which we want to compute the heuristic.
@@ -153,11 +195,15 @@ SearchStatus LazySearch::step() {
     // - current_operator is the operator which leads to current_state from predecessor.
     // - current_g is the g value of the current state according to the cost_type
     // - current_real_g is the g value of the current state (using real costs)
+    // - current_bounded_g is the g value of the current state according to
+    //   the bounded costs; it never exceeds the cost bound of the task
+    //   (edges are checked against the bound on insertion and on removal)
+    // - current_utility is the utility of the current state
 
 
     SearchNode node = search_space.get_node(current_state);
     bool reopen = reopen_closed_nodes && !node.is_new() &&
-        !node.is_dead_end() && (current_g < node.get_g());
+        !node.is_dead_end() && is_cheaper_path(node);
 
     if (node.is_new() || reopen) {
         if (current_operator_id != OperatorID::no_operator) {
@@ -169,6 +215,7 @@ SearchStatus LazySearch::step() {
         }
         statistics.inc_evaluated_states();
         if (!open_list->is_dead_end(current_eval_context)) {
+            search_space.set_state_utility(current_state, current_utility);
             // TODO: Generalize code for using multiple evaluators.
             if (current_predecessor_id == StateID::no_state) {
                 node.open_initial();
@@ -178,11 +225,12 @@ SearchStatus LazySearch::step() {
                 GlobalState parent_state = state_registry.lookup_state(current_predecessor_id);
                 SearchNode parent_node = search_space.get_node(parent_state);
                 OperatorProxy current_operator = task_proxy.get_operators()[current_operator_id];
+                int adjusted_cost = current_g - parent_node.get_g();
                 if (reopen) {
-                    node.reopen(parent_node, current_operator, get_adjusted_cost(current_operator));
+                    node.reopen(parent_node, current_operator, adjusted_cost);
                     statistics.inc_reopened();
                 } else {
-                    node.open(parent_node, current_operator, get_adjusted_cost(current_operator));
+                    node.open(parent_node, current_operator, adjusted_cost);
                 }
             }
             node.close();
@@ -38,6 +38,8 @@ protected:
     OperatorID current_operator_id;
     int current_g;
     int current_real_g;
+    int current_bounded_g;
+    int current_utility;
     EvaluationContext current_eval_context;
 
     virtual void initialize() override;
@@ -51,6 +53,8 @@ protected:
     std::vector<OperatorID> get_successor_operators(
         const ordered_set::OrderedSet<OperatorID> &preferred_operators) const;
 
+    bool is_cheaper_path(const SearchNode &node) const;
+
     // TODO: Move into SearchEngine?
     void print_checkpoint_line(int g) const;
 
@@ -32,7 +32,14 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "lazy_evaluator",
         "An evaluator that re-evaluates a state before it is expanded.",
         OptionParser::NONE);
+    parser.add_option<bool>(
+        "bucket_open_list",
+        "use bucket_tiebreaking instead of tiebreaking as open list. Both "
+        "expand states in the same order, but the bucket-based open list "
+        "is faster for integer evaluator values.",
+        "false");
 
+    eager_search::add_options_to_parser(parser);
     SearchEngine::add_pruning_option(parser);
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
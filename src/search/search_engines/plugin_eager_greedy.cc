@@ -55,6 +55,7 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
         "boost",
         "boost value for preferred operator open lists", "0");
 
+    eager_search::add_options_to_parser(parser);
     SearchEngine::add_pruning_option(parser);
     SearchEngine::add_options_to_parser(parser);
 
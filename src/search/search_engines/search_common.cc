@@ -9,6 +9,7 @@
 #include "../evaluators/weighted_evaluator.h"
 
 #include "../open_lists/alternation_open_list.h"
+#include "../open_lists/bucket_tiebreaking_open_list.h"
 #include "../open_lists/standard_scalar_open_list.h"
 #include "../open_lists/tiebreaking_open_list.h"
 
@@ -124,8 +125,11 @@ create_astar_open_list_factory_and_f_eval(const Options &opts) {
     options.set("evals", evals);
     options.set("pref_only", false);
     options.set("unsafe_pruning", false);
-    shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    shared_ptr<OpenListFactory> open;
+    if (opts.get<bool>("bucket_open_list"))
+        open = make_shared<bucket_tiebreaking_open_list::BucketTieBreakingOpenListFactory>(options);
+    else
+        open = make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
     return make_pair(open, f);
 }
 }
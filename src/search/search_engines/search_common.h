@@ -73,7 +73,9 @@ extern std::shared_ptr<OpenListFactory> create_wastar_open_list_factory(
 
   The resulting open list factory produces a tie-breaking open list
   ordered primarily on g + h and secondarily on h. Uses "eval" from
-  the passed-in Options object as the h evaluator.
+  the passed-in Options object as the h evaluator, and the bucket-based
+  tie-breaking open list instead of the map-based one if
+  "bucket_open_list" is set.
 */
 extern std::pair<std::shared_ptr<OpenListFactory>, const std::shared_ptr<Evaluator>>
 create_astar_open_list_factory_and_f_eval(const options::Options &opts);
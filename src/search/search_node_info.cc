@@ -1,11 +1,50 @@
 #include "search_node_info.h"
 
-// static const int pointer_bytes = sizeof(void *);
-// static const int info_bytes = 3 * sizeof(int) + sizeof(StateID);
-// static const int info_bytes = 4 * sizeof(int) + sizeof(StateID);
-// static const int padding_bytes = info_bytes % pointer_bytes;
-
-// static_assert(
-//     sizeof(SearchNodeInfo) == info_bytes + padding_bytes,
-//     "The size of SearchNodeInfo is larger than expected. This probably means "
-//     "that packing two fields into one integer using bitfields is not supported.");
+#include <limits>
+
+using namespace std;
+
+static_assert(
+    sizeof(SearchNodeInfo) == 2 * sizeof(int) + sizeof(StateID),
+    "The size of SearchNodeInfo is larger than expected. This probably means "
+    "that packing two fields into one integer using bitfields is not supported.");
+
+static int get_num_bits(uint32_t value) {
+    int num_bits = 0;
+    while (value) {
+        ++num_bits;
+        value >>= 1;
+    }
+    return num_bits;
+}
+
+SearchNodeLayout::SearchNodeLayout(
+    int num_operators, int cost_bound, bool store_real_g)
+    : operator_bits(32),
+      operator_mask(numeric_limits<uint32_t>::max()),
+      bounded_g_is_packed(false),
+      max_packed_bounded_g(-1),
+      real_g_is_stored(store_real_g) {
+    assert(num_operators >= 0);
+    if (cost_bound >= 0 && cost_bound < numeric_limits<int>::max()) {
+        // Operator indices are stored plus one; bounded g values saturate
+        // at cost_bound + 1.
+        int needed_operator_bits = get_num_bits(num_operators);
+        int needed_bounded_g_bits = get_num_bits(cost_bound + 1);
+        if (needed_operator_bits + needed_bounded_g_bits <= 32) {
+            operator_bits = 32 - needed_bounded_g_bits;
+            operator_mask = (uint32_t(1) << operator_bits) - 1;
+            bounded_g_is_packed = true;
+            max_packed_bounded_g = cost_bound + 1;
+        }
+    }
+}
+
+int SearchNodeLayout::get_bytes_per_node() const {
+    int bytes = sizeof(SearchNodeInfo);
+    if (!bounded_g_is_packed)
+        bytes += sizeof(int);
+    if (real_g_is_stored)
+        bytes += sizeof(int);
+    return bytes;
+}
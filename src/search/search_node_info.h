@@ -4,24 +4,93 @@
 #include "operator_id.h"
 #include "state_id.h"
 
+#include <cassert>
+#include <cstdint>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
+/*
+  Per-state search information. To keep the search space small, the real g
+  value and the bounded g value are not always stored here: SearchNodeLayout
+  determines how the creating operator and the bounded g value share the
+  last field, and SearchSpace keeps separate tables for the values that do
+  not fit.
+*/
 struct SearchNodeInfo {
     enum NodeStatus {NEW = 0, OPEN = 1, CLOSED = 2, DEAD_END = 3};
 
     unsigned int status : 2;
     int g : 30;
     StateID parent_state_id;
-    OperatorID creating_operator;
-    int real_g;
-
-    int bounded_g;
+    std::uint32_t creating_operator_and_bounded_g;
 
     SearchNodeInfo()
         : status(NEW), g(-1), parent_state_id(StateID::no_state),
-          creating_operator(-1), real_g(-1), bounded_g(-1) {
+          creating_operator_and_bounded_g(0) {
+    }
+};
+
+/*
+  Decides which fields of a search node are stored and how.
+
+  - The real g value is only stored (in a separate table) if the search
+    uses adjusted operator costs. With cost type NORMAL, it equals g.
+  - The bounded g value is packed into the upper bits of
+    creating_operator_and_bounded_g if all bounded g values up to the cost
+    bound fit next to the operator index. Larger values, which the search
+    never needs to distinguish, are saturated at cost bound + 1. Otherwise
+    (e.g., without a finite cost bound), it is stored in a separate table.
+  - The creating operator is stored as its index plus one (0 for none) in
+    the lower bits of creating_operator_and_bounded_g.
+*/
+class SearchNodeLayout {
+    int operator_bits;
+    std::uint32_t operator_mask;
+    bool bounded_g_is_packed;
+    int max_packed_bounded_g;
+    bool real_g_is_stored;
+public:
+    SearchNodeLayout(int num_operators, int cost_bound, bool store_real_g);
+
+    bool is_bounded_g_packed() const {
+        return bounded_g_is_packed;
+    }
+
+    bool is_real_g_stored() const {
+        return real_g_is_stored;
     }
+
+    OperatorID get_creating_operator(const SearchNodeInfo &info) const {
+        int index = static_cast<int>(
+            info.creating_operator_and_bounded_g & operator_mask) - 1;
+        return index == -1 ? OperatorID::no_operator : OperatorID(index);
+    }
+
+    int get_packed_bounded_g(const SearchNodeInfo &info) const {
+        assert(bounded_g_is_packed);
+        return static_cast<int>(
+            info.creating_operator_and_bounded_g >> operator_bits);
+    }
+
+    void set_creating_operator(SearchNodeInfo &info, OperatorID op_id) const {
+        std::uint32_t op_part = static_cast<std::uint32_t>(op_id.get_index() + 1);
+        assert(op_part <= operator_mask);
+        info.creating_operator_and_bounded_g =
+            (info.creating_operator_and_bounded_g & ~operator_mask) | op_part;
+    }
+
+    void set_packed_bounded_g(SearchNodeInfo &info, int bounded_g) const {
+        assert(bounded_g_is_packed && bounded_g >= 0);
+        if (bounded_g > max_packed_bounded_g)
+            bounded_g = max_packed_bounded_g;
+        info.creating_operator_and_bounded_g =
+            (info.creating_operator_and_bounded_g & operator_mask) |
+            (static_cast<std::uint32_t>(bounded_g) << operator_bits);
+    }
+
+    // Bytes per search node, including the separate tables.
+    int get_bytes_per_node() const;
 };
 
 #endif
@@ -10,11 +10,19 @@ using namespace std;
 
 SearchNode::SearchNode(const StateRegistry &state_registry,
                        StateID state_id,
-                       SearchNodeInfo &info)
+                       SearchNodeInfo &info,
+                       const SearchNodeLayout &layout,
+                       int *real_g,
+                       int *bounded_g)
     : state_registry(state_registry),
       state_id(state_id),
-      info(info) {
+      info(info),
+      layout(layout),
+      real_g(real_g),
+      bounded_g(bounded_g) {
     assert(state_id != StateID::no_state);
+    assert((real_g != nullptr) == layout.is_real_g_stored());
+    assert((bounded_g == nullptr) == layout.is_bounded_g_packed());
 }
 
 GlobalState SearchNode::get_state() const {
@@ -43,22 +51,46 @@ int SearchNode::get_g() const {
 }
 
 int SearchNode::get_real_g() const {
-    return info.real_g;
+    return real_g ? *real_g : info.g;
 }
 
 int SearchNode::get_bounded_g() const {
-    assert(info.bounded_g >= 0);
-    return info.bounded_g;
+    int value = bounded_g ? *bounded_g : layout.get_packed_bounded_g(info);
+    assert(value >= 0);
+    return value;
+}
+
+OperatorID SearchNode::get_creating_operator() const {
+    return layout.get_creating_operator(info);
+}
+
+void SearchNode::set_parent(const SearchNode &parent_node,
+                            const OperatorProxy &parent_op,
+                            int adjusted_cost) {
+    info.g = parent_node.info.g + adjusted_cost;
+    if (real_g)
+        *real_g = parent_node.get_real_g() + parent_op.get_cost();
+    int new_bounded_g = parent_node.get_bounded_g() + parent_op.get_bounded_cost();
+    if (bounded_g)
+        *bounded_g = new_bounded_g;
+    else
+        layout.set_packed_bounded_g(info, new_bounded_g);
+    info.parent_state_id = parent_node.get_state_id();
+    layout.set_creating_operator(info, OperatorID(parent_op.get_id()));
 }
 
 void SearchNode::open_initial() {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
     info.g = 0;
-    info.real_g = 0;
-    info.bounded_g = 0;
+    if (real_g)
+        *real_g = 0;
+    if (bounded_g)
+        *bounded_g = 0;
+    else
+        layout.set_packed_bounded_g(info, 0);
     info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    layout.set_creating_operator(info, OperatorID::no_operator);
 }
 
 void SearchNode::open(const SearchNode &parent_node,
@@ -66,11 +98,7 @@ void SearchNode::open(const SearchNode &parent_node,
                       int adjusted_cost) {
     assert(info.status == SearchNodeInfo::NEW);
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.bounded_g = parent_node.info.bounded_g + parent_op.get_bounded_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen(const SearchNode &parent_node,
@@ -82,11 +110,7 @@ void SearchNode::reopen(const SearchNode &parent_node,
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
     info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.bounded_g = parent_node.info.bounded_g + parent_op.get_bounded_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
@@ -97,11 +121,7 @@ void SearchNode::update_parent(const SearchNode &parent_node,
            info.status == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.bounded_g = parent_node.info.bounded_g + parent_op.get_bounded_cost();
-    info.parent_state_id = parent_node.get_state_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_parent(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close() {
@@ -116,9 +136,10 @@ void SearchNode::mark_as_dead_end() {
 void SearchNode::dump(const TaskProxy &task_proxy) const {
     cout << state_id << ": ";
     get_state().dump_fdr();
-    if (info.creating_operator != OperatorID::no_operator) {
+    OperatorID creating_operator = get_creating_operator();
+    if (creating_operator != OperatorID::no_operator) {
         OperatorsProxy operators = task_proxy.get_operators();
-        OperatorProxy op = operators[info.creating_operator.get_index()];
+        OperatorProxy op = operators[creating_operator.get_index()];
         cout << " created by " << op.get_name()
              << " from " << info.parent_state_id << endl;
     } else {
@@ -126,12 +147,18 @@ void SearchNode::dump(const TaskProxy &task_proxy) const {
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry &state_registry)
-    : state_registry(state_registry) {
+SearchSpace::SearchSpace(StateRegistry &state_registry, OperatorCost cost_type)
+    : layout(state_registry.get_task_proxy().get_operators().size(),
+             state_registry.get_task_proxy().get_cost_bound(),
+             cost_type != OperatorCost::NORMAL),
+      state_registry(state_registry) {
 }
 
 SearchNode SearchSpace::get_node(const GlobalState &state) {
-    return SearchNode(state_registry, state.get_id(), search_node_infos[state]);
+    int *real_g = layout.is_real_g_stored() ? &real_g_values[state] : nullptr;
+    int *bounded_g = layout.is_bounded_g_packed() ? nullptr : &bounded_g_values[state];
+    return SearchNode(state_registry, state.get_id(), search_node_infos[state],
+                      layout, real_g, bounded_g);
 }
 
 void SearchSpace::trace_path(const GlobalState &goal_state,
@@ -140,11 +167,12 @@ void SearchSpace::trace_path(const GlobalState &goal_state,
     assert(path.empty());
     for (;;) {
         const SearchNodeInfo &info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
+        OperatorID creating_operator = layout.get_creating_operator(info);
+        if (creating_operator == OperatorID::no_operator) {
             assert(info.parent_state_id == StateID::no_state);
             break;
         }
-        path.push_back(info.creating_operator);
+        path.push_back(creating_operator);
         current_state = state_registry.lookup_state(info.parent_state_id);
     }
     reverse(path.begin(), path.end());
@@ -157,11 +185,12 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
            a search node without discarding the const qualifier. */
         GlobalState state = state_registry.lookup_state(id);
         const SearchNodeInfo &node_info = search_node_infos[state];
+        OperatorID creating_operator = layout.get_creating_operator(node_info);
         cout << id << ": ";
         state.dump_fdr();
-        if (node_info.creating_operator != OperatorID::no_operator &&
+        if (creating_operator != OperatorID::no_operator &&
             node_info.parent_state_id != StateID::no_state) {
-            OperatorProxy op = operators[node_info.creating_operator.get_index()];
+            OperatorProxy op = operators[creating_operator.get_index()];
             cout << " created by " << op.get_name()
                  << " from " << node_info.parent_state_id << endl;
         } else {
@@ -172,4 +201,5 @@ void SearchSpace::dump(const TaskProxy &task_proxy) const {
 
 void SearchSpace::print_statistics() const {
     state_registry.print_statistics();
+    cout << "Bytes per search node: " << layout.get_bytes_per_node() << endl;
 }
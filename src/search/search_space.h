@@ -17,10 +17,21 @@ class SearchNode {
     const StateRegistry &state_registry;
     StateID state_id;
     SearchNodeInfo &info;
+    const SearchNodeLayout &layout;
+    // Entries in the separate tables of the search space, if used.
+    int *real_g;
+    int *bounded_g;
+
+    void set_parent(const SearchNode &parent_node,
+                    const OperatorProxy &parent_op,
+                    int adjusted_cost);
 public:
     SearchNode(const StateRegistry &state_registry,
                StateID state_id,
-               SearchNodeInfo &info);
+               SearchNodeInfo &info,
+               const SearchNodeLayout &layout,
+               int *real_g,
+               int *bounded_g);
 
     StateID get_state_id() const {
         return state_id;
@@ -35,6 +46,7 @@ public:
     int get_g() const;
     int get_real_g() const;
     int get_bounded_g() const;
+    OperatorID get_creating_operator() const;
 
     void open_initial();
     void open(const SearchNode &parent_node,
@@ -54,13 +66,30 @@ public:
 
 
 class SearchSpace {
+    SearchNodeLayout layout;
     PerStateInformation<SearchNodeInfo> search_node_infos;
+    // Only used if the layout does not store these values in the node infos.
+    PerStateInformation<int> real_g_values;
+    PerStateInformation<int> bounded_g_values;
+    /*
+      Utility of each state, maintained incrementally along transitions by
+      search engines that need it (e.g. for the state-dependent cost of the
+      OSP end action). Only allocated once it is accessed.
+    */
+    PerStateInformation<int> state_utilities;
 
     StateRegistry &state_registry;
 public:
-    explicit SearchSpace(StateRegistry &state_registry);
+    SearchSpace(StateRegistry &state_registry, OperatorCost cost_type);
 
     SearchNode get_node(const GlobalState &state);
+
+    int get_state_utility(const GlobalState &state) const {
+        return state_utilities[state];
+    }
+    void set_state_utility(const GlobalState &state, int utility) {
+        state_utilities[state] = utility;
+    }
     void trace_path(const GlobalState &goal_state,
                     std::vector<OperatorID> &path) const;
 
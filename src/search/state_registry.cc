@@ -5,18 +5,71 @@
 
 #include "task_utils/task_properties.h"
 
+#include <algorithm>
+
 using namespace std;
 
-StateRegistry::StateRegistry(const TaskProxy &task_proxy)
+StateRegistry::StateRegistry(
+    const TaskProxy &task_proxy,
+    const shared_ptr<mapped_segment_pool::MappedSegmentPool> &mapped_pool)
     : task_proxy(task_proxy),
       state_packer(task_properties::g_state_packers[task_proxy]),
       axiom_evaluator(g_axiom_evaluators[task_proxy]),
       num_variables(task_proxy.get_variables().size()),
-      state_data_pool(get_bins_per_state()),
+      mapped_pool(mapped_pool),
+      state_data_pool(
+          get_bins_per_state(),
+          mapped_segment_pool::MappedSegmentAllocator<PackedStateBin>(mapped_pool)),
       registered_states(
           StateIDSemanticHash(state_data_pool, get_bins_per_state()),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state())),
       cached_initial_state(0) {
+    compile_packed_effects();
+}
+
+void StateRegistry::compile_packed_effects() {
+    OperatorsProxy operators = task_proxy.get_operators();
+    packed_effect_offsets.reserve(operators.size() + 1);
+    has_conditional_effects.reserve(operators.size());
+    vector<PackedEffect> op_effects;
+    for (OperatorProxy op : operators) {
+        packed_effect_offsets.push_back(packed_effects.size());
+        op_effects.clear();
+        bool is_conditional = false;
+        for (EffectProxy effect : op.get_effects()) {
+            if (!effect.get_conditions().empty()) {
+                is_conditional = true;
+                break;
+            }
+            FactPair fact = effect.get_fact().get_pair();
+            PackedEffect packed_effect;
+            packed_effect.bin_index = state_packer.get_bin_index(fact.var);
+            packed_effect.clear_mask = state_packer.get_clear_mask(fact.var);
+            packed_effect.value_bits = state_packer.get_value_bits(fact.var, fact.value);
+            op_effects.push_back(packed_effect);
+        }
+        has_conditional_effects.push_back(is_conditional);
+        if (is_conditional)
+            continue;
+
+        // Merge the effects on the same bin into one assignment.
+        sort(op_effects.begin(), op_effects.end(),
+             [](const PackedEffect &lhs, const PackedEffect &rhs) {
+                 return lhs.bin_index < rhs.bin_index;
+             });
+        for (const PackedEffect &effect : op_effects) {
+            if (packed_effects.size() > static_cast<size_t>(packed_effect_offsets.back()) &&
+                packed_effects.back().bin_index == effect.bin_index) {
+                PackedEffect &merged = packed_effects.back();
+                merged.clear_mask &= effect.clear_mask;
+                merged.value_bits = (merged.value_bits & effect.clear_mask) |
+                    effect.value_bits;
+            } else {
+                packed_effects.push_back(effect);
+            }
+        }
+    }
+    packed_effect_offsets.push_back(packed_effects.size());
 }
 
 
@@ -71,13 +124,49 @@ GlobalState StateRegistry::get_successor_state(const GlobalState &predecessor, c
     assert(!op.is_axiom());
     state_data_pool.push_back(predecessor.get_packed_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
-    for (EffectProxy effect : op.get_effects()) {
-        if (does_fire(effect, predecessor)) {
-            FactPair effect_pair = effect.get_fact().get_pair();
-            state_packer.set(buffer, effect_pair.var, effect_pair.value);
+    apply_effects(predecessor, op, buffer);
+    axiom_evaluator.evaluate(buffer, state_packer);
+    StateID id = insert_id_or_pop_state();
+    return lookup_state(id);
+}
+
+void StateRegistry::apply_effects(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) const {
+    int op_id = op.get_id();
+    if (has_conditional_effects[op_id]) {
+        for (EffectProxy effect : op.get_effects()) {
+            if (does_fire(effect, predecessor)) {
+                FactPair effect_pair = effect.get_fact().get_pair();
+                state_packer.set(buffer, effect_pair.var, effect_pair.value);
+            }
+        }
+    } else {
+        const PackedEffect *effect = packed_effects.data() + packed_effect_offsets[op_id];
+        const PackedEffect *end = packed_effects.data() + packed_effect_offsets[op_id + 1];
+        for (; effect != end; ++effect) {
+            PackedStateBin &bin = buffer[effect->bin_index];
+            bin = (bin & effect->clear_mask) | effect->value_bits;
         }
     }
-    axiom_evaluator.evaluate(buffer, state_packer);
+}
+
+void StateRegistry::copy_state(const GlobalState &state, PackedStateBin *buffer) const {
+    const PackedStateBin *data = state.get_packed_buffer();
+    copy(data, data + get_bins_per_state(), buffer);
+}
+
+void StateRegistry::compute_successor_state(
+    const GlobalState &predecessor, const OperatorProxy &op,
+    PackedStateBin *buffer) const {
+    assert(!op.is_axiom());
+    assert(!task_properties::has_axioms(task_proxy));
+    copy_state(predecessor, buffer);
+    apply_effects(predecessor, op, buffer);
+}
+
+GlobalState StateRegistry::register_state(const PackedStateBin *buffer) {
+    state_data_pool.push_back(buffer);
     StateID id = insert_id_or_pop_state();
     return lookup_state(id);
 }
@@ -93,4 +182,6 @@ int StateRegistry::get_state_size_in_bytes() const {
 void StateRegistry::print_statistics() const {
     cout << "Number of registered states: " << size() << endl;
     registered_states.print_statistics();
+    if (mapped_pool)
+        mapped_pool->print_statistics();
 }
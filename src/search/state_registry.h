@@ -8,11 +8,14 @@
 
 #include "algorithms/int_hash_set.h"
 #include "algorithms/int_packer.h"
+#include "algorithms/mapped_segment_pool.h"
 #include "algorithms/segmented_vector.h"
 #include "algorithms/subscriber.h"
 #include "utils/hash.h"
 
+#include <memory>
 #include <set>
+#include <vector>
 
 /*
   Overview of classes relevant to storing and working with registered states.
@@ -60,6 +63,9 @@
     This class is used to store the actual (packed) state data for all states
     while avoiding dynamically allocating each state individually.
     The index within this vector corresponds to the ID of the state.
+    Its segments are allocated on the heap or, if the registry is given a
+    MappedSegmentPool, in a memory-mapped file that can be paged out to
+    disk. In both cases, the address of a state's data never changes.
 
   PerStateInformation<T>
     Associates a value of type T with every state in a given StateRegistry.
@@ -109,40 +115,37 @@
 */
 
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin, mapped_segment_pool::MappedSegmentAllocator<PackedStateBin>>;
+
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
         }
 
         int_hash_set::HashType operator()(int id) const {
-            const PackedStateBin *data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+            return utils::get_hash32_of_words(state_data_pool[id], state_size);
         }
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool;
+        const StateDataPool &state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin> &state_data_pool,
+            const StateDataPool &state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool),
               state_size(state_size) {
         }
 
         bool operator()(int lhs, int rhs) const {
-            const PackedStateBin *lhs_data = state_data_pool[lhs];
-            const PackedStateBin *rhs_data = state_data_pool[rhs];
-            return std::equal(lhs_data, lhs_data + state_size, rhs_data);
+            return utils::are_words_equal(
+                state_data_pool[lhs], state_data_pool[rhs], state_size);
         }
     };
 
@@ -153,20 +156,52 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     */
     using StateIDSet = int_hash_set::IntHashSet<StateIDSemanticHash, StateIDSemanticEqual>;
 
+    /*
+      Assignment of all effects of an operator that affect one bin of the
+      packed state: bin = (bin & clear_mask) | value_bits.
+    */
+    struct PackedEffect {
+        int bin_index;
+        PackedStateBin clear_mask;
+        PackedStateBin value_bits;
+    };
+
     TaskProxy task_proxy;
     const int_packer::IntPacker &state_packer;
     AxiomEvaluator &axiom_evaluator;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    std::shared_ptr<mapped_segment_pool::MappedSegmentPool> mapped_pool;
+    StateDataPool state_data_pool;
     StateIDSet registered_states;
 
+    /*
+      Precompiled effects of all operators without conditional effects:
+      the effects of operator i are
+      packed_effects[packed_effect_offsets[i]..packed_effect_offsets[i+1]).
+      Operators with conditional effects have no precompiled effects and
+      are applied through the task interface.
+    */
+    std::vector<int> packed_effect_offsets;
+    std::vector<PackedEffect> packed_effects;
+    std::vector<bool> has_conditional_effects;
+
     GlobalState *cached_initial_state;
 
+    void compile_packed_effects();
+    void apply_effects(const GlobalState &predecessor, const OperatorProxy &op,
+                       PackedStateBin *buffer) const;
+
     StateID insert_id_or_pop_state();
-    int get_bins_per_state() const;
 public:
-    explicit StateRegistry(const TaskProxy &task_proxy);
+    /*
+      If mapped_pool is given, the state data is stored in it instead of
+      on the heap. The hash set used for duplicate detection always stays
+      on the heap.
+    */
+    explicit StateRegistry(
+        const TaskProxy &task_proxy,
+        const std::shared_ptr<mapped_segment_pool::MappedSegmentPool> &mapped_pool = nullptr);
     ~StateRegistry();
 
     const TaskProxy &get_task_proxy() const {
@@ -200,6 +235,21 @@ public:
     */
     GlobalState get_successor_state(const GlobalState &predecessor, const OperatorProxy &op);
 
+    /*
+      The following methods allow creating states in one registry and
+      registering them in another one for the same task, e.g., when the
+      state space is partitioned among several registries. Buffers must
+      have get_bins_per_state() bins. compute_successor_state() does not
+      evaluate axioms and must only be used for tasks without axioms.
+    */
+    void copy_state(const GlobalState &state, PackedStateBin *buffer) const;
+    void compute_successor_state(
+        const GlobalState &predecessor, const OperatorProxy &op,
+        PackedStateBin *buffer) const;
+    GlobalState register_state(const PackedStateBin *buffer);
+
+    int get_bins_per_state() const;
+
     /*
       Returns the number of states registered so far.
     */
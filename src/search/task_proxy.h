@@ -472,6 +472,11 @@ public:
       return task->get_operator_cost(index, is_an_axiom, state);
     }
 
+    // Same as get_cost(state) for any state with the given utility.
+    int get_cost_for_utility(int state_utility) const {
+        return task->get_operator_cost_for_utility(index, is_an_axiom, state_utility);
+    }
+
     int get_bounded_cost() const {
         return task->get_bounded_operator_cost(index, is_an_axiom);
     }
@@ -714,6 +719,9 @@ public:
     int get_state_utility(const GlobalState& state) const {
       return task->get_state_utility(state);
     }
+    int get_fact_utility(const FactPair &fact) const {
+        return task->get_fact_utility(fact);
+    }
 };
 
 
@@ -1,7 +1,7 @@
 #include "successor_generator.h"
 
 #include "successor_generator_factory.h"
-#include "successor_generator_internals.h"
+#include "task_properties.h"
 
 #include "../abstract_task.h"
 #include "../global_state.h"
@@ -10,19 +10,18 @@ using namespace std;
 
 namespace successor_generator {
 SuccessorGenerator::SuccessorGenerator(const TaskProxy &task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create()) {
+    : generator(SuccessorGeneratorFactory(task_proxy).create_flat(
+                    task_properties::g_state_packers[task_proxy])) {
 }
 
-SuccessorGenerator::~SuccessorGenerator() = default;
-
 void SuccessorGenerator::generate_applicable_ops(
     const State &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    generator.generate_applicable_ops(state, applicable_ops);
 }
 
 void SuccessorGenerator::generate_applicable_ops(
     const GlobalState &state, vector<OperatorID> &applicable_ops) const {
-    root->generate_applicable_ops(state, applicable_ops);
+    generator.generate_applicable_ops(state, applicable_ops);
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
@@ -1,6 +1,8 @@
 #ifndef TASK_UTILS_SUCCESSOR_GENERATOR_H
 #define TASK_UTILS_SUCCESSOR_GENERATOR_H
 
+#include "successor_generator_flat.h"
+
 #include "../per_task_information.h"
 
 #include <memory>
@@ -12,19 +14,12 @@ class State;
 class TaskProxy;
 
 namespace successor_generator {
-class GeneratorBase;
-
+// The decision tree is evaluated in its flat encoding (see FlatGenerator).
 class SuccessorGenerator {
-    std::unique_ptr<GeneratorBase> root;
+    FlatGenerator generator;
 
 public:
     explicit SuccessorGenerator(const TaskProxy &task_proxy);
-    /*
-      We cannot use the default destructor (implicitly or explicitly)
-      here because GeneratorBase is a forward declaration and the
-      incomplete type cannot be destroyed.
-    */
-    ~SuccessorGenerator();
 
     void generate_applicable_ops(
         const State &state, std::vector<OperatorID> &applicable_ops) const;
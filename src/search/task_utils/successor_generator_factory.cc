@@ -1,11 +1,10 @@
 #include "successor_generator_factory.h"
 
-#include "successor_generator_internals.h"
+#include "successor_generator_flat.h"
 
 #include "../task_proxy.h"
 
-#include "../utils/collections.h"
-#include "../utils/memory.h"
+#include "../algorithms/int_packer.h"
 
 #include <algorithm>
 #include <cassert>
@@ -47,7 +46,7 @@ using namespace std;
   To make the implementation more efficient, we do not physically pop
   conditions but only keep track of how many conditions have been
   dealt with so far, which is simply the recursion depth of the
-  "construct_recursive" function.
+  "emit_recursive" function.
 
   Because we only consider contiguous subranges of the operator
   sequence and never need to modify any of the data describing the
@@ -172,73 +171,80 @@ SuccessorGeneratorFactory::SuccessorGeneratorFactory(
 
 SuccessorGeneratorFactory::~SuccessorGeneratorFactory() = default;
 
-GeneratorPtr SuccessorGeneratorFactory::construct_fork(
-    vector<GeneratorPtr> nodes) const {
-    int size = nodes.size();
-    if (size == 1) {
-        return move(nodes.at(0));
-    } else if (size == 2) {
-        return utils::make_unique_ptr<GeneratorForkBinary>(
-            move(nodes.at(0)), move(nodes.at(1)));
-    } else {
-        /* This general case includes the case size == 0, which can
-           (only) happen for the root for tasks with no operators. */
-        return utils::make_unique_ptr<GeneratorForkMulti>(move(nodes));
-    }
+static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
+    vector<FactPair> precond;
+    precond.reserve(op.get_preconditions().size());
+    for (FactProxy pre : op.get_preconditions())
+        precond.emplace_back(pre.get_pair());
+    // Preconditions must be sorted by variable.
+    sort(precond.begin(), precond.end());
+    return precond;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::construct_leaf(
-    OperatorRange range) const {
-    assert(!range.empty());
-    vector<OperatorID> operators;
-    operators.reserve(range.span());
-    while (range.begin != range.end) {
-        operators.emplace_back(operator_infos[range.begin].get_op());
-        ++range.begin;
-    }
+int SuccessorGeneratorFactory::emit_fork(
+    const vector<int> &children, vector<int> &code) const {
+    if (children.size() == 1)
+        return children.front();
+    int node = code.size();
+    code.push_back(FlatGenerator::FORK);
+    code.push_back(children.size());
+    code.insert(code.end(), children.begin(), children.end());
+    return node;
+}
 
-    if (operators.size() == 1) {
-        return utils::make_unique_ptr<GeneratorLeafSingle>(operators.front());
-    } else {
-        return utils::make_unique_ptr<GeneratorLeafVector>(move(operators));
-    }
+int SuccessorGeneratorFactory::emit_leaf(
+    OperatorRange range, vector<int> &code) const {
+    assert(!range.empty());
+    int node = code.size();
+    code.push_back(FlatGenerator::LEAF);
+    code.push_back(range.span());
+    for (int i = range.begin; i != range.end; ++i)
+        code.push_back(operator_infos[i].get_op().get_index());
+    return node;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::construct_switch(
-    int switch_var_id, ValuesAndGenerators values_and_generators) const {
+int SuccessorGeneratorFactory::emit_switch(
+    int switch_var_id, const vector<pair<int, int>> &values_and_children,
+    const int_packer::IntPacker &state_packer, vector<int> &code) const {
     VariablesProxy variables = task_proxy.get_variables();
     int var_domain = variables[switch_var_id].get_domain_size();
-    int num_children = values_and_generators.size();
-
+    int num_children = values_and_children.size();
     assert(num_children > 0);
 
+    int node = code.size();
+    code.push_back(-1);
+    code.push_back(switch_var_id);
+    code.push_back(state_packer.get_bin_index(switch_var_id));
+    code.push_back(state_packer.get_shift(switch_var_id));
+    code.push_back(static_cast<int>(~state_packer.get_clear_mask(switch_var_id)));
     if (num_children == 1) {
-        int value = values_and_generators[0].first;
-        GeneratorPtr generator = move(values_and_generators[0].second);
-        return utils::make_unique_ptr<GeneratorSwitchSingle>(
-            switch_var_id, value, move(generator));
-    }
-
-    int vector_bytes = utils::estimate_vector_bytes<GeneratorPtr>(var_domain);
-    int hash_bytes = utils::estimate_unordered_map_bytes<int, GeneratorPtr>(num_children);
-    if (hash_bytes < vector_bytes) {
-        unordered_map<int, GeneratorPtr> generator_by_value;
-        for (auto &item : values_and_generators)
-            generator_by_value[item.first] = move(item.second);
-        return utils::make_unique_ptr<GeneratorSwitchHash>(
-            switch_var_id, move(generator_by_value));
+        code[node] = FlatGenerator::SWITCH_SINGLE;
+        code.push_back(values_and_children[0].first);
+        code.push_back(values_and_children[0].second);
+    } else if (var_domain <= 2 * num_children) {
+        // A table indexed by value is not larger than a sorted switch.
+        code[node] = FlatGenerator::SWITCH_VECTOR;
+        code.push_back(var_domain);
+        int children_begin = code.size();
+        code.resize(children_begin + var_domain, FlatGenerator::NO_CHILD);
+        for (const auto &item : values_and_children)
+            code[children_begin + item.first] = item.second;
     } else {
-        vector<GeneratorPtr> generator_by_value(var_domain);
-        for (auto &item : values_and_generators)
-            generator_by_value[item.first] = move(item.second);
-        return utils::make_unique_ptr<GeneratorSwitchVector>(
-            switch_var_id, move(generator_by_value));
+        // The values are sorted because the operators are sorted.
+        code[node] = FlatGenerator::SWITCH_SORTED;
+        code.push_back(num_children);
+        for (const auto &item : values_and_children)
+            code.push_back(item.first);
+        for (const auto &item : values_and_children)
+            code.push_back(item.second);
     }
+    return node;
 }
 
-GeneratorPtr SuccessorGeneratorFactory::construct_recursive(
-    int depth, OperatorRange range) const {
-    vector<GeneratorPtr> nodes;
+int SuccessorGeneratorFactory::emit_recursive(
+    int depth, OperatorRange range,
+    const int_packer::IntPacker &state_packer, vector<int> &code) const {
+    vector<int> nodes;
     OperatorGrouper grouper_by_var(
         operator_infos, depth, GroupOperatorsBy::VAR, range);
     while (!grouper_by_var.done()) {
@@ -247,40 +253,24 @@ GeneratorPtr SuccessorGeneratorFactory::construct_recursive(
         OperatorRange var_range = var_group.second;
 
         if (var == -1) {
-            // Handle a group of immediately applicable operators.
-            nodes.push_back(construct_leaf(var_range));
+            nodes.push_back(emit_leaf(var_range, code));
         } else {
-            // Handle a group of operators sharing the first precondition variable.
-            ValuesAndGenerators values_and_generators;
+            vector<pair<int, int>> values_and_children;
             OperatorGrouper grouper_by_value(
                 operator_infos, depth, GroupOperatorsBy::VALUE, var_range);
             while (!grouper_by_value.done()) {
                 auto value_group = grouper_by_value.next();
-                int value = value_group.first;
-                OperatorRange value_range = value_group.second;
-
-                values_and_generators.emplace_back(
-                    value, construct_recursive(depth + 1, value_range));
+                values_and_children.emplace_back(
+                    value_group.first,
+                    emit_recursive(depth + 1, value_group.second, state_packer, code));
             }
-
-            nodes.push_back(construct_switch(
-                                var, move(values_and_generators)));
+            nodes.push_back(emit_switch(var, values_and_children, state_packer, code));
         }
     }
-    return construct_fork(move(nodes));
-}
-
-static vector<FactPair> build_sorted_precondition(const OperatorProxy &op) {
-    vector<FactPair> precond;
-    precond.reserve(op.get_preconditions().size());
-    for (FactProxy pre : op.get_preconditions())
-        precond.emplace_back(pre.get_pair());
-    // Preconditions must be sorted by variable.
-    sort(precond.begin(), precond.end());
-    return precond;
+    return emit_fork(nodes, code);
 }
 
-GeneratorPtr SuccessorGeneratorFactory::create() {
+void SuccessorGeneratorFactory::init_operator_infos() {
     OperatorsProxy operators = task_proxy.get_operators();
     operator_infos.reserve(operators.size());
     for (OperatorProxy op : operators) {
@@ -290,10 +280,16 @@ GeneratorPtr SuccessorGeneratorFactory::create() {
     /* Use stable_sort rather than sort for reproducibility.
        This amounts to breaking ties by operator ID. */
     stable_sort(operator_infos.begin(), operator_infos.end());
+}
 
+FlatGenerator SuccessorGeneratorFactory::create_flat(
+    const int_packer::IntPacker &state_packer) {
+    init_operator_infos();
     OperatorRange full_range(0, operator_infos.size());
-    GeneratorPtr root = construct_recursive(0, full_range);
+    vector<int> code;
+    int root = emit_recursive(0, full_range, state_packer, code);
     operator_infos.clear();
-    return root;
+    code.shrink_to_fit();
+    return FlatGenerator(move(code), root);
 }
 }
@@ -1,36 +1,45 @@
 #ifndef TASK_UTILS_SUCCESSOR_GENERATOR_FACTORY_H
 #define TASK_UTILS_SUCCESSOR_GENERATOR_FACTORY_H
 
-#include <memory>
 #include <vector>
 
 class TaskProxy;
 
-namespace successor_generator {
-class GeneratorBase;
+namespace int_packer {
+class IntPacker;
+}
 
-using GeneratorPtr = std::unique_ptr<GeneratorBase>;
+namespace successor_generator {
+class FlatGenerator;
 
 struct OperatorRange;
 class OperatorInfo;
 
 
 class SuccessorGeneratorFactory {
-    using ValuesAndGenerators = std::vector<std::pair<int, GeneratorPtr>>;
-
     const TaskProxy &task_proxy;
     std::vector<OperatorInfo> operator_infos;
 
-    GeneratorPtr construct_fork(std::vector<GeneratorPtr> nodes) const;
-    GeneratorPtr construct_leaf(OperatorRange range) const;
-    GeneratorPtr construct_switch(
-        int switch_var_id, ValuesAndGenerators values_and_generators) const;
-    GeneratorPtr construct_recursive(int depth, OperatorRange range) const;
+    // These append the nodes of the decision tree to code and return their positions.
+    int emit_fork(const std::vector<int> &children, std::vector<int> &code) const;
+    int emit_leaf(OperatorRange range, std::vector<int> &code) const;
+    int emit_switch(
+        int switch_var_id, const std::vector<std::pair<int, int>> &values_and_children,
+        const int_packer::IntPacker &state_packer, std::vector<int> &code) const;
+    int emit_recursive(
+        int depth, OperatorRange range,
+        const int_packer::IntPacker &state_packer, std::vector<int> &code) const;
+
+    void init_operator_infos();
 public:
     explicit SuccessorGeneratorFactory(const TaskProxy &task_proxy);
     // Destructor cannot be implicit because OperatorInfo is forward-declared.
     ~SuccessorGeneratorFactory();
-    GeneratorPtr create();
+    /*
+      Create the flat encoding of the decision tree. Values are read from
+      packed states with the given state packer.
+    */
+    FlatGenerator create_flat(const int_packer::IntPacker &state_packer);
 };
 }
 
@@ -0,0 +1,126 @@
+#include "successor_generator_flat.h"
+
+#include "../global_state.h"
+#include "../task_proxy.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace successor_generator {
+const int FlatGenerator::SWITCH_VAR;
+const int FlatGenerator::SWITCH_BIN;
+const int FlatGenerator::SWITCH_SHIFT;
+const int FlatGenerator::SWITCH_MASK;
+const int FlatGenerator::SWITCH_HEADER_SIZE;
+const int FlatGenerator::NO_CHILD;
+
+namespace {
+class UnpackedValueReader {
+    const vector<int> &values;
+public:
+    explicit UnpackedValueReader(const State &state)
+        : values(state.get_values()) {
+    }
+
+    int operator()(const int *switch_node) const {
+        return values[switch_node[FlatGenerator::SWITCH_VAR]];
+    }
+};
+
+class PackedValueReader {
+    const PackedStateBin *buffer;
+public:
+    explicit PackedValueReader(const PackedStateBin *buffer)
+        : buffer(buffer) {
+    }
+
+    int operator()(const int *switch_node) const {
+        PackedStateBin bin = buffer[switch_node[FlatGenerator::SWITCH_BIN]];
+        PackedStateBin mask = static_cast<PackedStateBin>(
+            switch_node[FlatGenerator::SWITCH_MASK]);
+        return (bin & mask) >> switch_node[FlatGenerator::SWITCH_SHIFT];
+    }
+};
+}
+
+FlatGenerator::FlatGenerator(vector<int> &&code, int root)
+    : code(move(code)),
+      root(root) {
+}
+
+template<typename ValueReader>
+void FlatGenerator::generate(
+    const ValueReader &read_value, vector<OperatorID> &applicable_ops) const {
+    if (root != NO_CHILD)
+        generate_from(root, read_value, applicable_ops);
+}
+
+template<typename ValueReader>
+void FlatGenerator::generate_from(
+    int node, const ValueReader &read_value,
+    vector<OperatorID> &applicable_ops) const {
+    /*
+      Switches and the last child of a fork are followed in the loop;
+      only the other children of forks need recursive calls.
+    */
+    while (node != NO_CHILD) {
+        const int *data = code.data() + node;
+        switch (data[0]) {
+        case FORK: {
+            int num_children = data[1];
+            const int *children = data + 2;
+            for (int i = 0; i < num_children - 1; ++i)
+                generate_from(children[i], read_value, applicable_ops);
+            node = num_children ? children[num_children - 1] : NO_CHILD;
+            break;
+        }
+        case SWITCH_VECTOR: {
+            int value = read_value(data);
+            assert(value < data[SWITCH_HEADER_SIZE]);
+            node = data[SWITCH_HEADER_SIZE + 1 + value];
+            break;
+        }
+        case SWITCH_SORTED: {
+            int value = read_value(data);
+            int num_children = data[SWITCH_HEADER_SIZE];
+            const int *values = data + SWITCH_HEADER_SIZE + 1;
+            const int *pos = lower_bound(values, values + num_children, value);
+            if (pos != values + num_children && *pos == value)
+                node = values[num_children + (pos - values)];
+            else
+                node = NO_CHILD;
+            break;
+        }
+        case SWITCH_SINGLE: {
+            if (read_value(data) == data[SWITCH_HEADER_SIZE])
+                node = data[SWITCH_HEADER_SIZE + 1];
+            else
+                node = NO_CHILD;
+            break;
+        }
+        case LEAF: {
+            int num_ops = data[1];
+            for (int i = 0; i < num_ops; ++i)
+                applicable_ops.emplace_back(data[2 + i]);
+            node = NO_CHILD;
+            break;
+        }
+        default:
+            assert(false);
+            node = NO_CHILD;
+        }
+    }
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const State &state, vector<OperatorID> &applicable_ops) const {
+    generate(UnpackedValueReader(state), applicable_ops);
+}
+
+void FlatGenerator::generate_applicable_ops(
+    const GlobalState &state, vector<OperatorID> &applicable_ops) const {
+    generate(PackedValueReader(state.get_packed_buffer()), applicable_ops);
+}
+}
@@ -0,0 +1,75 @@
+#ifndef TASK_UTILS_SUCCESSOR_GENERATOR_FLAT_H
+#define TASK_UTILS_SUCCESSOR_GENERATOR_FLAT_H
+
+#include "../operator_id.h"
+
+#include <vector>
+
+class GlobalState;
+class State;
+
+namespace successor_generator {
+/*
+  Successor generator decision tree encoded in a single int vector
+  ("byte code") that is evaluated by an interpreter loop without virtual
+  calls. Nodes are referenced by their position in the vector and have the
+  following layouts, where c_i are child positions:
+
+  - fork:          [FORK, n, c_1, ..., c_n]
+  - vector switch: [SWITCH_VECTOR, var, bin, shift, mask, d, c_0, ..., c_{d-1}]
+                   where c_v is NO_CHILD if no operator requires var = v
+  - sorted switch: [SWITCH_SORTED, var, bin, shift, mask, k,
+                    v_1, ..., v_k, c_1, ..., c_k]  with v_1 < ... < v_k
+  - single switch: [SWITCH_SINGLE, var, bin, shift, mask, v, c]
+  - leaf:          [LEAF, n, op_1, ..., op_n]
+
+  Switch nodes store where the variable is located in the packed state
+  (see IntPacker), so that values can be read from the buffer of a
+  GlobalState directly.
+
+  The operators are reported in the same order as by the tree of
+  polymorphic nodes that this encoding replaced.
+*/
+class FlatGenerator {
+public:
+    enum NodeType {
+        FORK,
+        SWITCH_VECTOR,
+        SWITCH_SORTED,
+        SWITCH_SINGLE,
+        LEAF
+    };
+
+    // Positions of the fields shared by all switch nodes.
+    static const int SWITCH_VAR = 1;
+    static const int SWITCH_BIN = 2;
+    static const int SWITCH_SHIFT = 3;
+    static const int SWITCH_MASK = 4;
+    static const int SWITCH_HEADER_SIZE = 5;
+
+    static const int NO_CHILD = -1;
+private:
+    std::vector<int> code;
+    int root;
+
+    template<typename ValueReader>
+    void generate(const ValueReader &read_value,
+                  std::vector<OperatorID> &applicable_ops) const;
+    template<typename ValueReader>
+    void generate_from(int node, const ValueReader &read_value,
+                       std::vector<OperatorID> &applicable_ops) const;
+public:
+    FlatGenerator(std::vector<int> &&code, int root);
+
+    void generate_applicable_ops(
+        const State &state, std::vector<OperatorID> &applicable_ops) const;
+    void generate_applicable_ops(
+        const GlobalState &state, std::vector<OperatorID> &applicable_ops) const;
+
+    int get_code_size() const {
+        return code.size();
+    }
+};
+}
+
+#endif
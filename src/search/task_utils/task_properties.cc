@@ -100,6 +100,22 @@ int get_max_bounded_operator_cost(TaskProxy task_proxy) {
     return max_cost;
 }
 
+int get_utility_delta(
+    const TaskProxy &task_proxy, const OperatorProxy &op, const GlobalState &state) {
+    int delta = 0;
+    for (EffectProxy effect : op.get_effects()) {
+        if (does_fire(effect, state)) {
+            FactPair effect_fact = effect.get_fact().get_pair();
+            int old_value = state[effect_fact.var];
+            if (old_value != effect_fact.value) {
+                delta += task_proxy.get_fact_utility(effect_fact) -
+                    task_proxy.get_fact_utility(FactPair(effect_fact.var, old_value));
+            }
+        }
+    }
+    return delta;
+}
+
 void print_variable_statistics(const TaskProxy &task_proxy) {
     const int_packer::IntPacker &state_packer = g_state_packers[task_proxy];
 
@@ -40,6 +40,16 @@ inline bool is_goal_state(const TaskProxy &task_proxy, const GlobalState &state)
 }
 
 
+/*
+  Return the change in utility caused by applying op in state, i.e.,
+  the utility of the successor minus the utility of state. Effects on
+  derived variables (axioms) are not taken into account.
+
+  Runtime: O(n), where n is the number of effects of op.
+*/
+extern int get_utility_delta(
+    const TaskProxy &task_proxy, const OperatorProxy &op, const GlobalState &state);
+
 /*
   Return true iff all operators have cost 1.
 
@@ -121,11 +121,11 @@ int DelegatingTask::get_cost_bound() const {
   return parent->get_cost_bound();
 }
 
-vector<FactPairUtility> DelegatingTask::get_fact_pair_utilities() const {
+const vector<FactPairUtility> &DelegatingTask::get_fact_pair_utilities() const {
   return parent->get_fact_pair_utilities();
 }
 
-std::map<int, std::map<int, int>> DelegatingTask::get_utilities_map() const {
+const std::map<int, std::map<int, int>> &DelegatingTask::get_utilities_map() const {
   return parent->get_utilities_map();
 }
 
@@ -137,4 +137,13 @@ int DelegatingTask::get_state_utility(const GlobalState& state) const {
   return parent->get_state_utility(state);
 }
 
+int DelegatingTask::get_fact_utility(const FactPair &fact) const {
+    return parent->get_fact_utility(fact);
+}
+
+int DelegatingTask::get_operator_cost_for_utility(
+    int index, bool is_axiom, int state_utility) const {
+    return parent->get_operator_cost_for_utility(index, is_axiom, state_utility);
+}
+
 }
@@ -64,11 +64,14 @@ public:
     }
 
     virtual int get_cost_bound() const override;
-    virtual std::vector<FactPairUtility> get_fact_pair_utilities() const override;
-    virtual std::map<int, std::map<int, int>> get_utilities_map() const override;
+    virtual const std::vector<FactPairUtility> &get_fact_pair_utilities() const override;
+    virtual const std::map<int, std::map<int, int>> &get_utilities_map() const override;
 
     virtual int get_max_possible_utility() const override;
     virtual int get_state_utility(const GlobalState& global_state) const override;
+    virtual int get_fact_utility(const FactPair &fact) const override;
+    virtual int get_operator_cost_for_utility(
+        int index, bool is_axiom, int state_utility) const override;
 
     virtual int get_bounded_operator_cost(int index, bool is_axiom) const override;
 };
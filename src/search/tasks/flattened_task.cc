@@ -0,0 +1,184 @@
+#include "flattened_task.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include <cassert>
+#include <iostream>
+
+using namespace std;
+
+namespace tasks {
+FlattenedTask::OperatorTable::OperatorTable(const AbstractTask &task, bool is_axiom) {
+    int num_ops = is_axiom ? task.get_num_axioms() : task.get_num_operators();
+    precondition_offsets.reserve(num_ops + 1);
+    effect_offsets.reserve(num_ops + 1);
+    costs.reserve(num_ops);
+    bounded_costs.reserve(num_ops);
+    for (int op = 0; op < num_ops; ++op) {
+        precondition_offsets.push_back(preconditions.size());
+        int num_preconditions = task.get_num_operator_preconditions(op, is_axiom);
+        for (int i = 0; i < num_preconditions; ++i)
+            preconditions.push_back(task.get_operator_precondition(op, i, is_axiom));
+
+        effect_offsets.push_back(effects.size());
+        int num_effects = task.get_num_operator_effects(op, is_axiom);
+        for (int eff = 0; eff < num_effects; ++eff) {
+            effects.push_back(task.get_operator_effect(op, eff, is_axiom));
+            effect_condition_offsets.push_back(effect_conditions.size());
+            int num_conditions = task.get_num_operator_effect_conditions(op, eff, is_axiom);
+            for (int i = 0; i < num_conditions; ++i)
+                effect_conditions.push_back(
+                    task.get_operator_effect_condition(op, eff, i, is_axiom));
+        }
+
+        costs.push_back(task.get_operator_cost(op, is_axiom));
+        bounded_costs.push_back(task.get_bounded_operator_cost(op, is_axiom));
+    }
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
+    effect_condition_offsets.push_back(effect_conditions.size());
+}
+
+FlattenedTask::FlattenedTask(const shared_ptr<AbstractTask> &parent)
+    : DelegatingTask(parent),
+      operators(*parent, false),
+      axioms(*parent, true),
+      cost_bound(parent->get_cost_bound()),
+      max_possible_utility(parent->get_max_possible_utility()) {
+    int num_variables = parent->get_num_variables();
+    domain_sizes.reserve(num_variables);
+    axiom_layers.reserve(num_variables);
+    default_axiom_values.reserve(num_variables);
+    utility_offsets.reserve(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        int domain_size = parent->get_variable_domain_size(var);
+        domain_sizes.push_back(domain_size);
+        axiom_layers.push_back(parent->get_variable_axiom_layer(var));
+        default_axiom_values.push_back(parent->get_variable_default_axiom_value(var));
+        utility_offsets.push_back(fact_utilities.size());
+        for (int value = 0; value < domain_size; ++value)
+            fact_utilities.push_back(parent->get_fact_utility(FactPair(var, value)));
+    }
+
+    int num_goals = parent->get_num_goals();
+    goals.reserve(num_goals);
+    for (int i = 0; i < num_goals; ++i)
+        goals.push_back(parent->get_goal_fact(i));
+}
+
+int FlattenedTask::get_num_variables() const {
+    return domain_sizes.size();
+}
+
+int FlattenedTask::get_variable_domain_size(int var) const {
+    return domain_sizes[var];
+}
+
+int FlattenedTask::get_variable_axiom_layer(int var) const {
+    return axiom_layers[var];
+}
+
+int FlattenedTask::get_variable_default_axiom_value(int var) const {
+    return default_axiom_values[var];
+}
+
+int FlattenedTask::get_operator_cost(int index, bool is_axiom) const {
+    return get_table(is_axiom).costs[index];
+}
+
+int FlattenedTask::get_bounded_operator_cost(int index, bool is_axiom) const {
+    return get_table(is_axiom).bounded_costs[index];
+}
+
+int FlattenedTask::get_num_operators() const {
+    return operators.costs.size();
+}
+
+int FlattenedTask::get_num_operator_preconditions(int index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    return table.precondition_offsets[index + 1] - table.precondition_offsets[index];
+}
+
+FactPair FlattenedTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    assert(fact_index < get_num_operator_preconditions(op_index, is_axiom));
+    return table.preconditions[table.precondition_offsets[op_index] + fact_index];
+}
+
+int FlattenedTask::get_num_operator_effects(int op_index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    return table.effect_offsets[op_index + 1] - table.effect_offsets[op_index];
+}
+
+int FlattenedTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    int effect = table.effect_offsets[op_index] + eff_index;
+    return table.effect_condition_offsets[effect + 1] -
+           table.effect_condition_offsets[effect];
+}
+
+FactPair FlattenedTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    int effect = table.effect_offsets[op_index] + eff_index;
+    return table.effect_conditions[table.effect_condition_offsets[effect] + cond_index];
+}
+
+FactPair FlattenedTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const OperatorTable &table = get_table(is_axiom);
+    assert(eff_index < get_num_operator_effects(op_index, is_axiom));
+    return table.effects[table.effect_offsets[op_index] + eff_index];
+}
+
+int FlattenedTask::get_num_axioms() const {
+    return axioms.costs.size();
+}
+
+int FlattenedTask::get_num_goals() const {
+    return goals.size();
+}
+
+FactPair FlattenedTask::get_goal_fact(int index) const {
+    return goals[index];
+}
+
+int FlattenedTask::get_cost_bound() const {
+    return cost_bound;
+}
+
+int FlattenedTask::get_max_possible_utility() const {
+    return max_possible_utility;
+}
+
+int FlattenedTask::get_fact_utility(const FactPair &fact) const {
+    return fact_utilities[utility_offsets[fact.var] + fact.value];
+}
+
+
+static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Flattened task",
+        "Copies the operators, axioms and goals of the given task "
+        "transformation into flat arrays, so that they can be accessed "
+        "without going through the chain of delegating tasks. "
+        "The root task can be flattened with the command line option "
+        "--flatten-root-task.");
+    parser.add_option<shared_ptr<AbstractTask>>(
+        "transform",
+        "Task transformation to flatten.",
+        "no_transform()");
+    Options opts = parser.parse();
+    if (parser.dry_run()) {
+        return nullptr;
+    } else {
+        return make_shared<FlattenedTask>(
+            opts.get<shared_ptr<AbstractTask>>("transform"));
+    }
+}
+
+static Plugin<AbstractTask> _plugin("flatten", _parse);
+}
@@ -0,0 +1,91 @@
+#ifndef TASKS_FLATTENED_TASK_H
+#define TASKS_FLATTENED_TASK_H
+
+#include "delegating_task.h"
+
+#include <memory>
+#include <vector>
+
+namespace tasks {
+/*
+  Task transformation that materializes the operators, axioms and goals of
+  its parent task (usually a chain of delegating tasks) into contiguous
+  arrays once, so that queries for preconditions, effects, costs and
+  bounded costs no longer pass through several levels of virtual dispatch
+  and index arithmetic. The task is otherwise identical to its parent.
+
+  Names, mutexes, the initial state and the state-dependent costs are
+  still delegated to the parent task, since they are either not used in
+  performance-critical code or cannot be precomputed.
+*/
+class FlattenedTask : public DelegatingTask {
+    struct OperatorTable {
+        // Preconditions of operator i are
+        // preconditions[precondition_offsets[i]..precondition_offsets[i+1]).
+        std::vector<int> precondition_offsets;
+        std::vector<FactPair> preconditions;
+        // Effects are numbered globally, analogously to preconditions.
+        std::vector<int> effect_offsets;
+        std::vector<FactPair> effects;
+        // Conditions of the effect with global number e.
+        std::vector<int> effect_condition_offsets;
+        std::vector<FactPair> effect_conditions;
+        std::vector<int> costs;
+        std::vector<int> bounded_costs;
+
+        OperatorTable(const AbstractTask &task, bool is_axiom);
+    };
+
+    std::vector<int> domain_sizes;
+    std::vector<int> axiom_layers;
+    std::vector<int> default_axiom_values;
+
+    OperatorTable operators;
+    OperatorTable axioms;
+    std::vector<FactPair> goals;
+
+    int cost_bound;
+    int max_possible_utility;
+    // The utility of fact (var, value) is fact_utilities[utility_offsets[var] + value].
+    std::vector<int> utility_offsets;
+    std::vector<int> fact_utilities;
+
+    const OperatorTable &get_table(bool is_axiom) const {
+        return is_axiom ? axioms : operators;
+    }
+public:
+    explicit FlattenedTask(const std::shared_ptr<AbstractTask> &parent);
+    virtual ~FlattenedTask() override = default;
+
+    virtual int get_num_variables() const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual int get_cost_bound() const override;
+    virtual int get_max_possible_utility() const override;
+    virtual int get_fact_utility(const FactPair &fact) const override;
+
+    virtual int get_bounded_operator_cost(int index, bool is_axiom) const override;
+};
+}
+
+#endif
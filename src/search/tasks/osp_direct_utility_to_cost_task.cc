@@ -151,6 +151,12 @@ int OSPDirectUtilityToCostTask::get_operator_cost(int index, bool is_axiom,
     return get_operator_cost(index, is_axiom);
 }
 
+int OSPDirectUtilityToCostTask::get_operator_cost_for_utility(
+    int index, bool is_axiom, int state_utility) const {
+    (void)state_utility;
+    return get_operator_cost(index, is_axiom);
+}
+
 string OSPDirectUtilityToCostTask::get_operator_name(int index, bool is_axiom) const {
     return index < parent->get_num_operators()
                ? parent->get_operator_name(index, is_axiom)
@@ -49,6 +49,8 @@ public:
 
     virtual int get_operator_cost(int index, bool is_axiom) const override;
     virtual int get_operator_cost(int index, bool is_axiom, const GlobalState& state) const override;    
+    virtual int get_operator_cost_for_utility(
+        int index, bool is_axiom, int state_utility) const override;
     virtual std::string get_operator_name(int index, bool is_axiom) const override;
     virtual int get_num_operators() const override;
     virtual int get_num_operator_preconditions(int index, bool is_axiom) const override;
@@ -105,6 +105,19 @@ int OSPSingleEndActionReformulationTask::get_operator_cost(int index, bool is_ax
     return 0;
 }
 
+int OSPSingleEndActionReformulationTask::get_operator_cost_for_utility(
+    int index, bool is_axiom, int state_utility) const {
+    (void)is_axiom;
+    if (index < parent->get_num_operators()) {
+        return 0;
+    }
+    if (index == parent->get_num_operators()) {
+        return get_max_possible_utility() - state_utility;
+    }
+    cerr << "No operator with index " << index << " in get_operator_cost_for_utility(), this is a bug." << endl;
+    return 0;
+}
+
 string OSPSingleEndActionReformulationTask::get_operator_name(int index, bool is_axiom) const {
     if (index < parent->get_num_operators()) {
         return parent->get_operator_name(index, is_axiom);
@@ -109,6 +109,12 @@ int OSPUtilityToCostTask::get_operator_cost(int index, bool is_axiom,
     return get_operator_cost(index, is_axiom);
 }
 
+int OSPUtilityToCostTask::get_operator_cost_for_utility(
+    int index, bool is_axiom, int state_utility) const {
+    (void)state_utility;
+    return get_operator_cost(index, is_axiom);
+}
+
 string OSPUtilityToCostTask::get_operator_name(int index, bool is_axiom) const {
     return index < parent->get_num_operators() - 1
                ? parent->get_operator_name(index, is_axiom)
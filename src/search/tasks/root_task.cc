@@ -70,6 +70,19 @@ class RootTask : public AbstractTask {
     // variable index --> var value --> utility
     std::map<int, std::map<int, int>> utilities_map;
 
+    /*
+      Flat copy of utilities_map built once at load time: the utility of
+      fact (var, value) is fact_utilities[utility_offsets[var] + value].
+      utility_variables lists the variables with at least one soft goal,
+      so that computing a state's utility only touches those.
+    */
+    vector<int> utility_offsets;
+    vector<int> fact_utilities;
+    vector<int> utility_variables;
+    int max_possible_utility = 0;
+
+    void build_utility_table();
+
     const ExplicitVariable &get_variable(int var) const;
     const ExplicitEffect &get_effect(int op_id, int effect_id, bool is_axiom) const;
     const ExplicitOperator &get_operator_or_axiom(int index, bool is_axiom) const;
@@ -88,6 +101,8 @@ public:
 
     virtual int get_operator_cost(int index, bool is_axiom) const override;
     virtual int get_operator_cost(int index, bool is_axiom, const GlobalState &state) const override;
+    virtual int get_operator_cost_for_utility(
+        int index, bool is_axiom, int state_utility) const override;
     virtual int get_bounded_operator_cost(int index, bool is_axiom) const override;
 
     virtual string get_operator_name(
@@ -119,11 +134,12 @@ public:
         const AbstractTask *ancestor_task) const override;
 
     virtual int get_cost_bound() const override;
-    virtual vector<FactPairUtility> get_fact_pair_utilities() const override;
-    virtual std::map<int, std::map<int, int>> get_utilities_map() const override;
+    virtual const vector<FactPairUtility> &get_fact_pair_utilities() const override;
+    virtual const std::map<int, std::map<int, int>> &get_utilities_map() const override;
 
     virtual int get_max_possible_utility() const override;
-  virtual int get_state_utility(const GlobalState& state) const override;
+    virtual int get_state_utility(const GlobalState& state) const override;
+    virtual int get_fact_utility(const FactPair &fact) const override;
 };
 
 
@@ -398,6 +414,7 @@ RootTask::RootTask(std::istream &in) {
       cout << "Fact " << get_fact_name({util.fact_pair.var, util.fact_pair.value})
 	   << " with utility " << util.utility << endl;
     }
+    build_utility_table();
 
     if (goals.empty() && fact_pair_utilities.empty()) {
       utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -419,6 +436,30 @@ RootTask::RootTask(std::istream &in) {
     axiom_evaluator.evaluate(initial_state_values);
 }
 
+void RootTask::build_utility_table() {
+    int num_variables = variables.size();
+    utility_offsets.resize(num_variables);
+    int num_facts = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        utility_offsets[var] = num_facts;
+        num_facts += variables[var].domain_size;
+    }
+    fact_utilities.assign(num_facts, 0);
+
+    max_possible_utility = 0;
+    for (const auto &var_entry : utilities_map) {
+        int var = var_entry.first;
+        int max_var_utility = 0;
+        for (const auto &val_util_entry : var_entry.second) {
+            fact_utilities[utility_offsets[var] + val_util_entry.first] =
+                val_util_entry.second;
+            max_var_utility = max(max_var_utility, val_util_entry.second);
+        }
+        utility_variables.push_back(var);
+        max_possible_utility += max_var_utility;
+    }
+}
+
 const ExplicitVariable &RootTask::get_variable(int var) const {
     assert(utils::in_bounds(var, variables));
     return variables[var];
@@ -486,6 +527,12 @@ int RootTask::get_operator_cost(int index, bool is_axiom, const GlobalState& sta
   return get_operator_or_axiom(index, is_axiom).cost;
 }
 
+int RootTask::get_operator_cost_for_utility(
+    int index, bool is_axiom, int state_utility) const {
+    (void) state_utility;
+    return get_operator_or_axiom(index, is_axiom).cost;
+}
+
 int RootTask::get_bounded_operator_cost(int index, bool is_axiom) const {
   (void) index;
   (void) is_axiom;
@@ -568,38 +615,31 @@ int RootTask::get_cost_bound() const {
   return cost_bound;
 }
 
-std::vector<FactPairUtility> RootTask::get_fact_pair_utilities() const {
+const vector<FactPairUtility> &RootTask::get_fact_pair_utilities() const {
   return fact_pair_utilities;
 }
 
-std::map<int, std::map<int, int>> RootTask::get_utilities_map() const {
+const std::map<int, std::map<int, int>> &RootTask::get_utilities_map() const {
   return utilities_map;
 }
 
 int RootTask::get_max_possible_utility() const {
-  std::vector<int> max_possible_utilities(get_num_variables());
-  for (const FactPairUtility& fpu : get_fact_pair_utilities()) {
-    max_possible_utilities[fpu.fact_pair.var] = std::max(max_possible_utilities[fpu.fact_pair.var],
-							 fpu.utility);
-  }
-
-  return std::accumulate(max_possible_utilities.begin(), max_possible_utilities.end(), 0);
+    return max_possible_utility;
 }
 
 int RootTask::get_state_utility(const GlobalState& state) const {
-  int utility = 0;
-  for (const auto& var_entry : get_utilities_map()) {
-    const int var = var_entry.first;
-    const std::map<int,int>& val_util_map = var_entry.second;
-
-    const int state_val = state[var];
-
-    const auto& val_util_entry = val_util_map.find(state_val);
-    if (val_util_entry != val_util_map.end()) {
-      utility += val_util_entry->second;
+    int utility = 0;
+    for (int var : utility_variables) {
+        utility += fact_utilities[utility_offsets[var] + state[var]];
     }
-  }
-  return utility;
+    return utility;
+}
+
+int RootTask::get_fact_utility(const FactPair &fact) const {
+    // Variables added by task transformations carry no utility.
+    if (fact.var >= static_cast<int>(utility_offsets.size()))
+        return 0;
+    return fact_utilities[utility_offsets[fact.var] + fact.value];
 }
 
 void read_root_task(std::istream &in) {
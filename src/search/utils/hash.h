@@ -4,6 +4,7 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -206,6 +207,86 @@ public:
 };
 
 
+/*
+  Hash an array of 32-bit words whose length is the same for all arrays
+  hashed into the same container, e.g. packed states.
+
+  HashState mixes three words at a time in a single dependency chain.
+  Here, pairs of words are combined into 64-bit words that are fed into
+  four independent 64-bit accumulators with a multiply-rotate step (the
+  round function of xxHash64), so compilers can interleave or vectorize
+  the lanes. The lanes are merged and the result is avalanched with the
+  finalizer of MurmurHash3, so all bits of the result depend on all input
+  bits, as required for open addressing.
+*/
+namespace hash_words_detail {
+static const std::uint64_t PRIME1 = 0x9e3779b185ebca87ULL;
+static const std::uint64_t PRIME2 = 0xc2b2ae3d27d4eb4fULL;
+
+inline std::uint64_t rotate64(std::uint64_t value, int offset) {
+    return (value << offset) | (value >> (64 - offset));
+}
+
+inline std::uint64_t mix_round(std::uint64_t acc, std::uint64_t input) {
+    return rotate64(acc + input * PRIME2, 31) * PRIME1;
+}
+
+inline std::uint64_t read64(const std::uint32_t *words) {
+    // Compiles to a single (possibly unaligned) load.
+    std::uint64_t value;
+    std::memcpy(&value, words, sizeof(value));
+    return value;
+}
+}
+
+inline std::uint32_t get_hash32_of_words(
+    const std::uint32_t *words, std::size_t num_words) {
+    using namespace hash_words_detail;
+    std::uint64_t lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+    std::size_t i = 0;
+    for (; i + 8 <= num_words; i += 8) {
+        for (int lane = 0; lane < 4; ++lane) {
+            lanes[lane] = mix_round(lanes[lane], read64(words + i + 2 * lane));
+        }
+    }
+    for (int lane = 0; i + 2 <= num_words; i += 2, ++lane) {
+        lanes[lane] = mix_round(lanes[lane], read64(words + i));
+    }
+    if (i < num_words) {
+        lanes[3] = mix_round(lanes[3], words[i]);
+    }
+    std::uint64_t hash = rotate64(lanes[0], 1) + rotate64(lanes[1], 7) +
+        rotate64(lanes[2], 12) + rotate64(lanes[3], 18);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return static_cast<std::uint32_t>(hash);
+}
+
+/*
+  Compare two arrays of 32-bit words of the given length. The comparison
+  accumulates the differences of 64-bit words instead of stopping at the
+  first difference, which avoids unpredictable branches and lets compilers
+  vectorize the loop. Hash tables that store the hashes of their entries
+  mostly compare equal arrays, which have to be scanned completely anyway.
+*/
+inline bool are_words_equal(
+    const std::uint32_t *lhs, const std::uint32_t *rhs, std::size_t num_words) {
+    using hash_words_detail::read64;
+    std::uint64_t difference = 0;
+    std::size_t i = 0;
+    for (; i + 2 <= num_words; i += 2) {
+        difference |= read64(lhs + i) ^ read64(rhs + i);
+    }
+    if (i < num_words) {
+        difference |= lhs[i] ^ rhs[i];
+    }
+    return difference == 0;
+}
+
+
 /*
   These functions add a new object to an existing HashState object.
 
@@ -0,0 +1,33 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace utils {
+void parallel_for(
+    int num_items, int num_threads, const function<void(int)> &func) {
+    num_threads = min(num_threads, num_items);
+    if (num_threads <= 1) {
+        for (int item = 0; item < num_items; ++item)
+            func(item);
+        return;
+    }
+
+    atomic<int> next_item(0);
+    auto work = [&]() {
+        for (int item = next_item++; item < num_items; item = next_item++)
+            func(item);
+    };
+    vector<thread> threads;
+    threads.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i)
+        threads.emplace_back(work);
+    work();
+    for (thread &t : threads)
+        t.join();
+}
+}
@@ -0,0 +1,20 @@
+#ifndef UTILS_PARALLEL_H
+#define UTILS_PARALLEL_H
+
+#include <functional>
+
+namespace utils {
+/*
+  Call func(i) for all i in [0, num_items) using up to num_threads threads,
+  one of which is the calling thread. Items are handed out one at a time, so
+  items of very different sizes are balanced automatically. Returns after all
+  calls have finished.
+
+  func must be safe to call concurrently for different items. With
+  num_threads <= 1, the items are processed in order in the calling thread.
+*/
+extern void parallel_for(
+    int num_items, int num_threads, const std::function<void(int)> &func);
+}
+
+#endif